@@ -0,0 +1,125 @@
+// Runs the benchmarks registered with BENCHMARK() and writes the results as JSON, e.g.
+//     survival_bench --filter EntityManager --out results.json
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+struct RegisteredBenchmark {
+    std::string mName;
+    std::vector<size_t> mNs;
+    std::function<void(BenchmarkState &)> mRun;
+};
+
+/// Constructed on first use, since benchmarks register themselves during static initialization
+std::vector<RegisteredBenchmark> &getBenchmarks() {
+    static std::vector<RegisteredBenchmark> benchmarks;
+    return benchmarks;
+}
+
+void printUsage() {
+    std::fprintf(stderr, "Usage: survival_bench [--filter SUBSTRING] [--min-time SECONDS] [--out FILE] [--workers N]\n"
+                         "       survival_bench --list\n");
+}
+
+/// Escape the characters that may not appear in a JSON string
+std::string escape(const std::string &string) {
+    std::string escaped;
+    for (char c : string) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+} // namespace
+
+bool registerBenchmark(const std::string &name, std::vector<size_t> ns, std::function<void(BenchmarkState &)> run) {
+    getBenchmarks().push_back({name, std::move(ns), std::move(run)});
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    std::string filter;
+    std::string outPath;
+    double minSeconds = 0.2;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue)
+            filter = argv[++i];
+        else if (arg == "--min-time" && hasValue)
+            minSeconds = std::atof(argv[++i]);
+        else if (arg == "--out" && hasValue)
+            outPath = argv[++i];
+        else if (arg == "--workers" && hasValue)
+            JobSystem::getInstance().setNumWorkers(static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10)));
+        else if (arg == "--list")
+            list = true;
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"context\": {\"min_time\": " << minSeconds
+         << ", \"workers\": " << JobSystem::getInstance().getNumWorkers() << "},\n  \"benchmarks\": [";
+
+    bool first = true;
+    for (const auto &benchmark : getBenchmarks()) {
+        if (benchmark.mName.find(filter) == std::string::npos)
+            continue;
+        if (list) {
+            std::cout << benchmark.mName << std::endl;
+            continue;
+        }
+
+        for (size_t n : benchmark.mNs) {
+            BenchmarkState state(n, minSeconds);
+            benchmark.mRun(state);
+
+            const double iterations = state.getIterations() > 0 ? static_cast<double>(state.getIterations()) : 1;
+            const double nsPerIteration = 1e9 * state.getSeconds() / iterations;
+            const double allocationsPerIteration = static_cast<double>(state.getAllocations()) / iterations;
+            // Progress goes to stderr so that stdout is only the JSON
+            std::fprintf(stderr, "%-60s %8zu %14.1f ns %12zu iterations %10.1f allocs\n", benchmark.mName.c_str(), n,
+                         nsPerIteration, state.getIterations(), allocationsPerIteration);
+
+            json << (first ? "\n" : ",\n") << "    {\"name\": \"" << escape(benchmark.mName) << "\", \"n\": " << n
+                 << ", \"iterations\": " << state.getIterations() << ", \"seconds\": " << state.getSeconds()
+                 << ", \"ns_per_iteration\": " << nsPerIteration << ", \"allocations_per_iteration\": ";
+            // Without allocation counting there is no number to give
+            if (isCountingAllocations())
+                json << allocationsPerIteration;
+            else
+                json << "null";
+            json << "}";
+            first = false;
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    if (list)
+        return 0;
+
+    if (outPath.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream out(outPath);
+        if (!out) {
+            std::fprintf(stderr, "Could not open %s\n", outPath.c_str());
+            return 1;
+        }
+        out << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Passed to each benchmark, which sets up its fixture for getN() and then times its code with measure()
+class BenchmarkState {
+  public:
+    BenchmarkState(size_t n, double minSeconds) : mN(n), mMinSeconds(minSeconds) {}
+
+    /// Size of the fixture to set up, e.g. the number of entities
+    size_t getN() const { return mN; }
+
+    /// Time body, calling it more and more times until the calls take at least the minimum time, so that even very fast
+    /// code is timed reliably. Allocations made by the calls are counted too. Should be called once per benchmark
+    template <typename F> void measure(F body) {
+        using Clock = std::chrono::steady_clock;
+        size_t iterations = 1;
+        while (true) {
+            const auto allocationsAtStart = getAllocationCounts();
+            const auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+                body();
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (seconds >= mMinSeconds || iterations >= MAX_ITERATIONS) {
+                mIterations = iterations;
+                mSeconds = seconds;
+                mAllocations = getAllocationCounts().mAllocations - allocationsAtStart.mAllocations;
+                return;
+            }
+            // Aim a little past the minimum time, growing by at least 2x and at most 100x a round
+            const double estimate = seconds > 0 ? 1.2 * mMinSeconds / seconds : 100.0;
+            const double growth = std::max(2.0, std::min(estimate, 100.0));
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * growth);
+        }
+    }
+
+    size_t getIterations() const { return mIterations; }
+    double getSeconds() const { return mSeconds; }
+    /// Number of allocations made by every thread while timing the last round
+    uint64_t getAllocations() const { return mAllocations; }
+
+  private:
+    static const size_t MAX_ITERATIONS = 1000000000;
+
+    size_t mN;
+    double mMinSeconds;
+    size_t mIterations{0};
+    double mSeconds{0};
+    uint64_t mAllocations{0};
+};
+
+/// Stop the compiler from optimizing away the computation of value
+template <typename T> void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+/// Add a benchmark to be run once for each of ns
+/// \return true, so that registration can initialize a static
+bool registerBenchmark(const std::string &name, std::vector<size_t> ns, std::function<void(BenchmarkState &)> run);
+
+/// Define a benchmark function and register it under name, e.g.
+///     BENCHMARK(getEntitiesAtPos, "EntityManager/getEntitiesAtPos", 100, 1000) { ...; state.measure([&] {...}); }
+#define BENCHMARK(function, name, ...)                                                                                 \
+    static void function(BenchmarkState &state);                                                                       \
+    static const bool function##Registered = registerBenchmark(name, {__VA_ARGS__}, function);                        \
+    static void function(BenchmarkState &state)
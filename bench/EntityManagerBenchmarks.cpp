@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "Fixtures.h"
+
+#include "Entity/EntityManager.h"
+
+namespace {
+const size_t NUM_QUERY_POSITIONS = 256;
+} // namespace
+
+BENCHMARK(getEntitiesAtPos, "EntityManager/getEntitiesAtPos", 100, 1000, 10000, 100000) {
+    auto *player = populateWorld(state.getN());
+    auto positions = getQueryPositions(*player, NUM_QUERY_POSITIONS);
+    auto &manager = EntityManager::getInstance();
+
+    size_t i = 0;
+    state.measure([&] { doNotOptimize(manager.getEntitiesAtPos(positions[i++ % NUM_QUERY_POSITIONS])); });
+}
+
+BENCHMARK(getEntitiesAtPosFaster, "EntityManager/getEntitiesAtPosFaster", 100, 1000, 10000, 100000) {
+    auto *player = populateWorld(state.getN());
+    auto positions = getQueryPositions(*player, NUM_QUERY_POSITIONS);
+    auto &manager = EntityManager::getInstance();
+
+    // Reset after every query, so the results don't pile up
+    Arena scratch;
+    size_t i = 0;
+    state.measure([&] {
+        doNotOptimize(manager.getEntitiesAtPosFaster(positions[i++ % NUM_QUERY_POSITIONS], scratch));
+        scratch.reset();
+    });
+}
+
+BENCHMARK(getEntitiesSurroundingFaster, "EntityManager/getEntitiesSurroundingFaster", 100, 1000, 10000, 100000) {
+    auto *player = populateWorld(state.getN());
+    auto positions = getQueryPositions(*player, NUM_QUERY_POSITIONS);
+    auto &manager = EntityManager::getInstance();
+
+    Arena scratch;
+    size_t i = 0;
+    state.measure([&] {
+        doNotOptimize(manager.getEntitiesSurroundingFaster(positions[i++ % NUM_QUERY_POSITIONS], scratch));
+        scratch.reset();
+    });
+}
+
+BENCHMARK(doCollisions, "EntityManager/doCollisions", 100, 1000, 10000, 100000) {
+    auto *player = populateWorld(state.getN());
+    auto positions = getQueryPositions(*player, NUM_QUERY_POSITIONS);
+    auto &manager = EntityManager::getInstance();
+
+    size_t i = 0;
+    state.measure([&] { doNotOptimize(manager.doCollisions(positions[i++ % NUM_QUERY_POSITIONS], *player)); });
+}
+
+BENCHMARK(recomputeCurrentEntities, "EntityManager/recomputeCurrentEntitiesOnScreenAndSurroundingScreens", 100, 1000,
+          10000, 100000) {
+    auto *player = populateWorld(state.getN());
+    auto &manager = EntityManager::getInstance();
+
+    state.measure([&] { manager.recomputeCurrentEntitiesOnScreenAndSurroundingScreens(player->getWorldPos()); });
+}
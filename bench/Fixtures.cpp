@@ -0,0 +1,46 @@
+#include "Fixtures.h"
+
+#include "Entity/EntityManager.h"
+#include "Entity/UI/StatusUIEntity.h"
+#include "Random.h"
+#include "World.h"
+
+#include <memory>
+
+PlayerEntity *populateWorld(size_t n, const std::function<void(PlayerEntity &)> &addEntities) {
+    auto &manager = EntityManager::getInstance();
+    manager.clear();
+
+    // Same starting position as the game
+    auto player = std::make_unique<PlayerEntity>();
+    player->setPos(World::SCREEN_WIDTH * 1000 + World::SCREEN_WIDTH / 2,
+                   World::SCREEN_HEIGHT * 1000 + World::SCREEN_HEIGHT / 2);
+    auto *playerPtr = player.get();
+    manager.addEntity(std::move(player));
+    manager.addEntity(std::make_unique<StatusUIEntity>(*playerPtr));
+
+    Pcg32 random(static_cast<uint64_t>(n));
+    const Point origin = World::worldPosToWorld(playerPtr->getWorldPos() - Point(4, 4));
+    for (size_t i = 0; i < n; ++i) {
+        auto entity = std::make_unique<Entity>("", "Rock", "$[grey]o");
+        entity->setPos(origin + Point(static_cast<int>(random.nextBelow(9 * World::SCREEN_WIDTH)),
+                                      static_cast<int>(random.nextBelow(9 * World::SCREEN_HEIGHT))));
+        manager.addEntity(std::move(entity));
+    }
+
+    if (addEntities)
+        addEntities(*playerPtr);
+    manager.initialize();
+    return playerPtr;
+}
+
+std::vector<Point> getQueryPositions(const PlayerEntity &player, size_t count) {
+    Pcg32 random;
+    const Point origin = World::worldPosToWorld(player.getWorldPos() - Point(1, 1));
+    std::vector<Point> positions;
+    positions.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        positions.push_back(origin + Point(static_cast<int>(random.nextBelow(3 * World::SCREEN_WIDTH)),
+                                           static_cast<int>(random.nextBelow(3 * World::SCREEN_HEIGHT))));
+    return positions;
+}
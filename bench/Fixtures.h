@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Entity/PlayerEntity.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/// Clear the EntityManager and fill it with a player in the middle of a 9x9 block of screens and n plain entities
+/// spread evenly over the block, so that about a ninth of them are on the player's screen and the surrounding ones
+/// \param addEntities if given, called with the player to add more entities before the EntityManager is initialised.
+/// Entities added afterwards each recompute the entities around the player, which makes adding many of them quadratic
+/// \return the player
+PlayerEntity *populateWorld(size_t n, const std::function<void(PlayerEntity &)> &addEntities = nullptr);
+
+/// Get count random positions on the player's screen and the surrounding screens, the same ones every time
+std::vector<Point> getQueryPositions(const PlayerEntity &player, size_t count);
@@ -0,0 +1,32 @@
+#include "Benchmark.h"
+
+#include "Font.h"
+#include "RenderSnapshot.h"
+
+namespace {
+/// Font string of n glyphs mixing plain characters, named characters and color changes, like the game's UI text
+std::string makeFontString(size_t n) {
+    std::string text;
+    for (size_t i = 0; i < n / 4; ++i)
+        text += "$[red]a$(heart)${black}b ";
+    return text;
+}
+} // namespace
+
+BENCHMARK(drawText, "Font/drawText", 100, 1000, 10000) {
+    Font font(NUM_PER_ROW, CHARS);
+    std::vector<GlyphCommand> commands;
+    font.setRecording(&commands);
+    const std::string text = makeFontString(state.getN());
+
+    state.measure([&] {
+        commands.clear();
+        font.drawText(text, 0, 0);
+        doNotOptimize(commands.data());
+    });
+}
+
+BENCHMARK(getFontStringLength, "Font/getFontStringLength", 100, 1000, 10000) {
+    const std::string text = makeFontString(state.getN());
+    state.measure([&] { doNotOptimize(Font::getFontStringLength(text)); });
+}
@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include "Fixtures.h"
+
+#include "Entity/EntityManager.h"
+#include "Entity/Items/Materials/GrassTuftEntity.h"
+#include "Entity/Items/Materials/TwigEntity.h"
+
+#include <limits>
+#include <memory>
+
+namespace {
+/// Entity that can carry any number of items
+struct PackhorseEntity : Entity {
+    PackhorseEntity() : Entity("", "Packhorse", "$[brown]h", 1, 1, 0, 1, 2, std::numeric_limits<int>::max()) {}
+
+    /// Put item in the inventory as addToInventory() does, but without summing the carrying weight each time, which
+    /// would make loading n items quadratic. The item must already be at the packhorse's position
+    void load(Entity &item) {
+        mInventory.push_back(item.mID);
+        item.mShouldRender = false;
+        item.mIsInAnInventory = true;
+    }
+};
+
+/// Add an entity carrying n crafting materials, alternating between twigs and grass tufts, to an otherwise empty world
+Entity *makeCarrier(size_t n) {
+    auto &manager = EntityManager::getInstance();
+    PackhorseEntity *carrierPtr = nullptr;
+    // Add everything before the manager is initialised, so that setting up stays linear in n
+    populateWorld(0, [&manager, &carrierPtr, n](PlayerEntity &player) {
+        auto carrier = std::make_unique<PackhorseEntity>();
+        carrier->setPos(player.getPos());
+        carrierPtr = carrier.get();
+        manager.addEntity(std::move(carrier));
+
+        for (size_t i = 0; i < n; ++i) {
+            std::unique_ptr<Entity> item;
+            if (i % 2 == 0)
+                item = std::make_unique<TwigEntity>();
+            else
+                item = std::make_unique<GrassTuftEntity>();
+            item->setPos(player.getPos());
+            carrierPtr->load(*item);
+            manager.addEntity(std::move(item));
+        }
+    });
+    return carrierPtr;
+}
+} // namespace
+
+BENCHMARK(getCarryingWeight, "Entity/getCarryingWeight", 100, 1000, 10000, 100000) {
+    auto *carrier = makeCarrier(state.getN());
+    state.measure([&] { doNotOptimize(carrier->getCarryingWeight()); });
+}
+
+BENCHMARK(filterInventoryForCraftingMaterials, "Entity/filterInventoryForCraftingMaterials", 100, 1000, 10000,
+          100000) {
+    auto *carrier = makeCarrier(state.getN());
+    const std::vector<std::string> materialTypes{"wood"};
+    state.measure([&] { doNotOptimize(carrier->filterInventoryForCraftingMaterials(materialTypes)); });
+}
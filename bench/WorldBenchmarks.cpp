@@ -0,0 +1,16 @@
+#include "Benchmark.h"
+#include "Fixtures.h"
+
+#include "World.h"
+
+BENCHMARK(randomizeScreen, "World/randomizeScreen", 100, 1000, 10000, 100000) {
+    auto *player = populateWorld(state.getN());
+    World world;
+
+    // Roll a screen that has not been generated yet every time, heading away from the populated screens
+    Point worldPos = player->getWorldPos() + Point(5, 0);
+    state.measure([&] {
+        world.randomizeScreen(worldPos);
+        worldPos += Point(1, 0);
+    });
+}
@@ -0,0 +1,110 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+/// Innermost zone the current thread is in, or nullptr if it is in none or the tracker was not tracking
+thread_local AllocationZone *tInnermostZone = nullptr;
+
+#ifdef SURVIVAL_PROFILING
+std::atomic<uint64_t> gNumAllocations{0};
+std::atomic<uint64_t> gNumAllocatedBytes{0};
+
+void *countedAllocate(std::size_t size) {
+    gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    gNumAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    AllocationZone::attribute(size);
+    // malloc(0) may return nullptr, but new must return a unique pointer
+    return std::malloc(size == 0 ? 1 : size);
+}
+#endif
+} // namespace
+
+AllocationCounts getAllocationCounts() {
+    AllocationCounts counts;
+#ifdef SURVIVAL_PROFILING
+    counts.mAllocations = gNumAllocations.load(std::memory_order_relaxed);
+    counts.mBytes = gNumAllocatedBytes.load(std::memory_order_relaxed);
+#endif
+    return counts;
+}
+
+AllocationZoneStats *AllocationTracker::getZone(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &zone = mZones[name];
+    if (zone == nullptr)
+        zone = std::make_unique<AllocationZoneStats>(name);
+    return zone.get();
+}
+
+std::vector<const AllocationZoneStats *> AllocationTracker::getZones() const {
+    std::vector<const AllocationZoneStats *> zones;
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto &zone : mZones)
+        zones.push_back(zone.second.get());
+    return zones;
+}
+
+void AllocationTracker::resetZones() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto &zone : mZones) {
+        zone.second->mAllocations.store(0, std::memory_order_relaxed);
+        zone.second->mBytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+AllocationZone::AllocationZone(AllocationZoneStats *stats) {
+    if (AllocationTracker::getInstance().isTracking()) {
+        // A zone re-entered by recursion is already counting
+        for (auto zone = tInnermostZone; zone != nullptr; zone = zone->mOuter)
+            if (zone->mStats == stats)
+                return;
+        mStats = stats;
+        mOuter = tInnermostZone;
+        tInnermostZone = this;
+    }
+}
+
+AllocationZone::~AllocationZone() {
+    if (mStats != nullptr)
+        tInnermostZone = mOuter;
+}
+
+void AllocationZone::attribute(std::size_t size) {
+    for (auto zone = tInnermostZone; zone != nullptr; zone = zone->mOuter) {
+        zone->mStats->mAllocations.fetch_add(1, std::memory_order_relaxed);
+        zone->mStats->mBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+
+#ifdef SURVIVAL_PROFILING
+// Replacing the global operator new makes every allocation in the program pay for the counting, so only profiling
+// builds do
+
+void *operator new(std::size_t size) {
+    void *pointer = countedAllocate(size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAllocate(size); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAllocate(size); }
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete[](void *pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { std::free(pointer); }
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { std::free(pointer); }
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Number of allocations made with operator new, and their total size in bytes
+struct AllocationCounts {
+    uint64_t mAllocations{0};
+    uint64_t mBytes{0};
+};
+
+/// Get the allocations made by every thread since the program started. With SURVIVAL_PROFILING, linking this replaces
+/// the global operator new with one that counts each allocation before calling malloc, so the difference between two
+/// calls is what was allocated in between. Without it nothing is counted, and the counts are always zero
+AllocationCounts getAllocationCounts();
+
+/// Are allocations counted by getAllocationCounts()? Only in builds with SURVIVAL_PROFILING, as counting adds to the
+/// cost of every allocation made by any thread
+constexpr bool isCountingAllocations() {
+#ifdef SURVIVAL_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// Allocations made inside an ALLOCATION_ZONE with a given name, including in the zones nested inside it
+struct AllocationZoneStats {
+    explicit AllocationZoneStats(std::string name) : mName(std::move(name)) {}
+
+    std::string mName;
+    std::atomic<uint64_t> mAllocations{0};
+    std::atomic<uint64_t> mBytes{0};
+};
+
+/// Attributes allocations to the zones they were made in while tracking, to find the code that allocates on hot paths.
+/// A zone only covers the thread that entered it, so work handed to the job system is attributed to the zones entered
+/// by the jobs themselves. Zones are added with ALLOCATION_ZONE, which costs one relaxed load while not tracking and
+/// compiles to nothing without SURVIVAL_PROFILING
+class AllocationTracker {
+  public:
+    /// Get the singleton instance
+    static AllocationTracker &getInstance() {
+        static AllocationTracker instance;
+        return instance;
+    }
+
+    AllocationTracker(const AllocationTracker &) = delete;
+    void operator=(const AllocationTracker &) = delete;
+
+    /// Start or stop attributing allocations to zones. Counts so far are kept
+    void setTracking(bool tracking) { mTracking.store(tracking, std::memory_order_relaxed); }
+    bool isTracking() const { return mTracking.load(std::memory_order_relaxed); }
+
+    /// Get the stats of the zone called name, creating them on first use. They live as long as the tracker
+    AllocationZoneStats *getZone(const std::string &name);
+    /// Get the stats of every zone that has been entered, or looked up with getZone
+    std::vector<const AllocationZoneStats *> getZones() const;
+    /// Set every zone's counts back to zero
+    void resetZones();
+
+  private:
+    AllocationTracker() = default;
+
+    std::atomic<bool> mTracking{false};
+
+    /// Guards the zones
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, std::unique_ptr<AllocationZoneStats>> mZones;
+};
+
+/// Attributes the allocations made by this thread in its scope to a zone, and to the zones it is nested in, if the
+/// tracker was tracking when it was entered
+class AllocationZone {
+  public:
+    explicit AllocationZone(AllocationZoneStats *stats);
+    ~AllocationZone();
+
+    AllocationZone(const AllocationZone &) = delete;
+    AllocationZone &operator=(const AllocationZone &) = delete;
+
+    /// Add an allocation to the innermost zone entered by the calling thread and every zone around it
+    static void attribute(std::size_t size);
+
+  private:
+    AllocationZoneStats *mStats{nullptr};
+    /// Zone that was innermost when this one was entered
+    AllocationZone *mOuter{nullptr};
+};
+
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+
+#ifdef SURVIVAL_PROFILING
+/// Attribute allocations in the rest of the enclosing scope to a zone called name
+#define ALLOCATION_ZONE(name)                                                                                          \
+    static AllocationZoneStats *const ALLOCATION_CONCAT(allocationZoneStats, __LINE__) =                               \
+        AllocationTracker::getInstance().getZone(name);                                                                \
+    AllocationZone ALLOCATION_CONCAT(allocationZone, __LINE__)(ALLOCATION_CONCAT(allocationZoneStats, __LINE__))
+#else
+#define ALLOCATION_ZONE(name) (void)0
+#endif
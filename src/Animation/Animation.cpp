@@ -0,0 +1,41 @@
+#include "Animation.h"
+#include "../Entity/Entity.h"
+#include "../Random.h"
+#include "AnimationSystem.h"
+
+const size_t Animation::NOT_REGISTERED;
+
+Animation::Animation(Entity &parent) : mParent(parent) { AnimationSystem::getInstance().add(this); }
+
+Animation::~Animation() { AnimationSystem::getInstance().remove(this); }
+
+FrameAnimation::FrameAnimation(Entity &parent, std::vector<std::string> frames, double secondsPerFrame,
+                               double jitterSeconds, bool randomOrder)
+    : Animation(parent), mFrames(std::move(frames)), mSecondsPerFrame(secondsPerFrame), mJitterSeconds(jitterSeconds),
+      mRandomOrder(randomOrder) {
+    if (!mFrames.empty())
+        mParent.mGraphic = mFrames.front();
+}
+
+void FrameAnimation::update(double time) {
+    if (mFrames.empty())
+        return;
+
+    auto &random = RandomStreams::getInstance().getStream(RandomStream::COSMETIC);
+    if (mNextFrameTime < 0) {
+        mNextFrameTime = time + mSecondsPerFrame + mJitterSeconds * random.nextDouble();
+        return;
+    }
+    if (time < mNextFrameTime)
+        return;
+
+    if (mRandomOrder)
+        mFrame = random.nextBelow(static_cast<uint32_t>(mFrames.size()));
+    else
+        mFrame = (mFrame + 1) % mFrames.size();
+    mParent.mGraphic = mFrames[mFrame];
+
+    // Count from now rather than from when the frame was due, so an animation that was off screen doesn't flick
+    // through the frames it missed
+    mNextFrameTime = time + mSecondsPerFrame + mJitterSeconds * random.nextDouble();
+}
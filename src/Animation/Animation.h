@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct Entity;
+/// Animation state of one entity, advanced by the AnimationSystem rather than while drawing, so that entities draw the
+/// same however many times they are drawn and animate at the same speed at any frame rate. Registers itself with the
+/// AnimationSystem on construction and unregisters on destruction, so an animated entity only has to own one
+class Animation {
+  public:
+    explicit Animation(Entity &parent);
+    virtual ~Animation();
+    Animation(const Animation &) = delete;
+    void operator=(const Animation &) = delete;
+
+    Entity &getParent() const { return mParent; }
+
+    /// Advance the animation, which may change its parent's graphic
+    /// \param time seconds on the frame clock
+    virtual void update(double time) = 0;
+
+  protected:
+    Entity &mParent;
+
+  private:
+    friend class AnimationSystem;
+
+    static const size_t NOT_REGISTERED = static_cast<size_t>(-1);
+
+    /// Index in the AnimationSystem's list, so that it can unregister without searching
+    size_t mSystemIndex{NOT_REGISTERED};
+};
+
+/// Shows each of a list of graphics for a while, in order or picking the next at random
+class FrameAnimation : public Animation {
+  public:
+    /// \param frames graphics to show, the first of which is shown until the first update
+    /// \param secondsPerFrame how long each frame is shown for
+    /// \param jitterSeconds up to this many seconds are added at random to how long each frame is shown
+    /// \param randomOrder pick each frame at random instead of going through them in order
+    FrameAnimation(Entity &parent, std::vector<std::string> frames, double secondsPerFrame, double jitterSeconds = 0,
+                   bool randomOrder = false);
+
+    void update(double time) override;
+
+  private:
+    std::vector<std::string> mFrames;
+    double mSecondsPerFrame;
+    double mJitterSeconds;
+    bool mRandomOrder;
+    size_t mFrame{0};
+    /// Time to show the next frame at, or negative before the first update
+    double mNextFrameTime{-1};
+};
@@ -0,0 +1,31 @@
+#include "AnimationSystem.h"
+#include "../AllocationCounter.h"
+#include "../Entity/Entity.h"
+#include "../Profiler.h"
+#include "Animation.h"
+
+void AnimationSystem::add(Animation *animation) {
+    animation->mSystemIndex = mAnimations.size();
+    mAnimations.push_back(animation);
+}
+
+void AnimationSystem::remove(Animation *animation) {
+    const auto index = animation->mSystemIndex;
+    if (index >= mAnimations.size() || mAnimations[index] != animation)
+        return;
+
+    mAnimations[index] = mAnimations.back();
+    mAnimations[index]->mSystemIndex = index;
+    mAnimations.pop_back();
+    animation->mSystemIndex = Animation::NOT_REGISTERED;
+}
+
+void AnimationSystem::update(double time, const FieldOfView &fov) {
+    PROFILE_ZONE("AnimationSystem::update");
+    ALLOCATION_ZONE("AnimationSystem::update");
+    for (auto animation : mAnimations) {
+        const auto &entity = animation->getParent();
+        if (!entity.mIsInAnInventory && entity.isVisibleIn(fov))
+            animation->update(time);
+    }
+}
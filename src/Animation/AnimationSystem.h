@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+class Animation;
+class FieldOfView;
+/// Singleton list of every entity's animation, which advances them all at once before entities are drawn. Animations
+/// of entities the player cannot see are skipped. Animation registers itself on construction and unregisters on
+/// destruction
+class AnimationSystem {
+  public:
+    /// Get the singleton instance. It is never destroyed, as the animations of entities held by other singletons, such
+    /// as EntityManager, unregister from it at exit
+    static AnimationSystem &getInstance() {
+        static auto *instance = new AnimationSystem;
+        return *instance;
+    }
+
+    AnimationSystem() = default;
+    // Singleton, so delete copy constructor and copy assignment operator
+    AnimationSystem(const AnimationSystem &) = delete;
+    void operator=(const AnimationSystem &) = delete;
+
+    /// Register animation to be updated
+    void add(Animation *animation);
+    /// Unregister animation, does nothing if it was not registered. Takes constant time, by moving the last animation
+    /// into its place
+    void remove(Animation *animation);
+
+    /// Advance the animations of the entities visible in fov
+    /// \param time seconds on the frame clock
+    void update(double time, const FieldOfView &fov);
+
+  private:
+    /// In no particular order. Each animation knows its own index
+    std::vector<Animation *> mAnimations;
+};
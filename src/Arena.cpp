@@ -0,0 +1,87 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace {
+/// Guards the list of tick arenas
+std::mutex gTickArenasMutex;
+/// Tick arena of every thread that has used one
+std::vector<Arena *> gTickArenas;
+
+/// The arenas of one thread, which register the tick arena so that every thread's can be reset between ticks
+struct ThreadArenas {
+    ThreadArenas() {
+        std::lock_guard<std::mutex> lock(gTickArenasMutex);
+        gTickArenas.push_back(&mTick);
+    }
+
+    ~ThreadArenas() {
+        std::lock_guard<std::mutex> lock(gTickArenasMutex);
+        gTickArenas.erase(std::remove(gTickArenas.begin(), gTickArenas.end(), &mTick), gTickArenas.end());
+    }
+
+    Arena mTick;
+    Arena mFrame;
+};
+
+thread_local ThreadArenas tArenas;
+} // namespace
+
+const size_t Arena::INITIAL_BLOCK_SIZE;
+
+void *Arena::allocate(size_t size, size_t alignment) {
+    mBytesAllocated += size;
+    if (!mBlocks.empty()) {
+        auto pointer = allocateFromLastBlock(size, alignment);
+        if (pointer != nullptr)
+            return pointer;
+    }
+
+    // Blocks double in size, so a tick or frame needs few of them even before the first reset merges them
+    size_t blockSize = mBlocks.empty() ? INITIAL_BLOCK_SIZE : 2 * mBlocks.back().mSize;
+    blockSize = std::max(blockSize, size + alignment);
+    mBlocks.push_back(Block{std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+    mUsed = 0;
+    return allocateFromLastBlock(size, alignment);
+}
+
+void *Arena::allocateFromLastBlock(size_t size, size_t alignment) {
+    auto &block = mBlocks.back();
+    auto address = reinterpret_cast<uintptr_t>(block.mData.get()) + mUsed;
+    auto padding = (alignment - address % alignment) % alignment;
+    if (mUsed + padding + size > block.mSize)
+        return nullptr;
+
+    auto pointer = block.mData.get() + mUsed + padding;
+    mUsed += padding + size;
+    return pointer;
+}
+
+void Arena::reset() {
+    if (mBlocks.size() > 1) {
+        const size_t capacity = getCapacity();
+        mBlocks.clear();
+        mBlocks.push_back(Block{std::unique_ptr<char[]>(new char[capacity]), capacity});
+    }
+    mUsed = 0;
+    mBytesAllocated = 0;
+}
+
+size_t Arena::getCapacity() const {
+    size_t capacity = 0;
+    for (const auto &block : mBlocks)
+        capacity += block.mSize;
+    return capacity;
+}
+
+Arena &Arena::getTickArena() { return tArenas.mTick; }
+
+Arena &Arena::getFrameArena() { return tArenas.mFrame; }
+
+void Arena::resetTickArenas() {
+    std::lock_guard<std::mutex> lock(gTickArenasMutex);
+    for (auto arena : gTickArenas)
+        arena->reset();
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Span.h"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/// Bump allocator for scratch data that is all thrown away at once. Allocating only moves a pointer along a block, and
+/// reset() frees everything at once while keeping the memory, so once an arena has grown to fit a tick or a frame it
+/// stops touching the heap. Destructors are never run, so only trivially destructible data should live in an arena.
+/// Not thread safe, so each thread has its own tick and frame arenas
+class Arena {
+  public:
+    /// Size of the first block, later blocks double in size
+    static const size_t INITIAL_BLOCK_SIZE = 16 * 1024;
+
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /// Get size bytes aligned to alignment, which must be a power of two, valid until the next reset
+    void *allocate(size_t size, size_t alignment);
+    /// Get uninitialised room for count elements of T
+    template <typename T> T *allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arenas never run destructors");
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /// Free everything allocated so far. If the allocations needed more than one block, the blocks are merged into one
+    /// big enough for all of them, so the next tick or frame fits in a single block
+    void reset();
+
+    /// Bytes handed out since the last reset, not counting alignment padding
+    size_t getBytesAllocated() const { return mBytesAllocated; }
+    /// Total size of the blocks
+    size_t getCapacity() const;
+
+    /// Get the calling thread's arena for data that lives until the next tick starts, e.g. the results of spatial
+    /// queries made while planning
+    static Arena &getTickArena();
+    /// Get the calling thread's arena for data that lives until the thread starts recording its next frame
+    static Arena &getFrameArena();
+    /// Reset every thread's tick arena. Must only be called while no other thread is using its tick arena, i.e.
+    /// between ticks
+    static void resetTickArenas();
+
+  private:
+    struct Block {
+        std::unique_ptr<char[]> mData;
+        size_t mSize;
+    };
+
+    /// Allocate from the last block, which must exist
+    /// \return nullptr if there is not enough room left in it
+    void *allocateFromLastBlock(size_t size, size_t alignment);
+
+    /// Blocks allocated from in order, only the last of which has room left
+    std::vector<Block> mBlocks;
+    /// Bytes used in the last block
+    size_t mUsed{0};
+    size_t mBytesAllocated{0};
+};
+
+/// Standard allocator that allocates from an arena, so that standard containers can be used as scratch space.
+/// Deallocating does nothing, so the elements of a container of trivially destructible elements stay readable after the
+/// container is destroyed, until the arena is reset. This is how query functions return spans of their results
+template <typename T> class ArenaAllocator {
+  public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena &arena) : mArena(&arena) {}
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : mArena(other.getArena()) {}
+
+    T *allocate(size_t count) { return static_cast<T *>(mArena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T *, size_t) {}
+
+    Arena *getArena() const { return mArena; }
+
+    template <typename U> bool operator==(const ArenaAllocator<U> &other) const { return mArena == other.getArena(); }
+    template <typename U> bool operator!=(const ArenaAllocator<U> &other) const { return mArena != other.getArena(); }
+
+  private:
+    Arena *mArena;
+};
+
+/// Vector of scratch data, e.g. ArenaVector<Entity *> results{ArenaAllocator<Entity *>(Arena::getTickArena())}
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -1,40 +1,31 @@
 #include "AttachmentBehaviour.h"
 #include "../../Entity/EntityManager.h"
 #include "../../Entity/PlayerEntity.h"
-#include "../../UI/NotificationMessageRenderer.h"
-#include "../../utils.h"
+#include "../../Intents.h"
 
-void AttachmentBehaviour::tick() {
-    auto r = randDouble();
+void AttachmentBehaviour::plan(Intents &intents) {
+    auto r = mParent.mRandom.nextDouble();
 
     if (!attached) {
         if (r < attachment) {
             PlayerEntity &p = dynamic_cast<PlayerEntity &>(*EntityManager::getInstance().getEntityByID("Player"));
-            if (mParent.getPos().distanceTo(p.getPos()) < 10) {
-                NotificationMessageRenderer::getInstance().queueMessage(mParent.mGraphic +
-                                                                        "$[red]$(heart)$[white]$(dwarf)");
+            if (mParent.getPos().distanceSquaredTo(p.getPos()) < range * range) {
+                intents.notify(mParent.mGraphic + "$[red]$(heart)$[white]$(dwarf)");
                 attached = true;
             }
         }
         return;
     }
 
-    PlayerEntity &p = dynamic_cast<PlayerEntity &>(*EntityManager::getInstance().getEntityByID("Player"));
+    auto &manager = EntityManager::getInstance();
+    Point playerPos = manager.getPlayerFlowField().getTarget();
 
     // Don't follow too closely
     auto pos = mParent.getPos();
-    if (pos.distanceTo(p.getPos()) > 2 && r < clinginess) {
-        if (pos.mX < p.getPos().mX)
-            pos.mX++;
-        else if (pos.mX > p.getPos().mX)
-            pos.mX--;
-        if (pos.mY < p.getPos().mY)
-            pos.mY++;
-        else if (pos.mY > p.getPos().mY)
-            pos.mY--;
-    }
+    if (pos.distanceSquaredTo(playerPos) > 2 * 2 && r < clinginess)
+        pos = manager.getNextStepTowards(mParent, playerPos);
 
-    mParent.moveTo(pos);
+    intents.moveTo(pos);
 
     if (r < unattachment) {
         attached = false;
@@ -5,6 +5,8 @@
 struct Entity;
 /// This behaviour causes the entity to randomly attach to and follow the entity with ID "Player"
 struct AttachmentBehaviour : Behaviour {
+    POOLED_ALLOCATION(AttachmentBehaviour)
+
     float attachment;
     float clinginess;
     float unattachment;
@@ -26,5 +28,5 @@ struct AttachmentBehaviour : Behaviour {
     AttachmentBehaviour(Entity &parent, float attachment, float clinginess, float unattachment)
         : AttachmentBehaviour(parent, attachment, clinginess, unattachment, 10) {}
 
-    void tick() override;
+    void plan(Intents &intents) override;
 };
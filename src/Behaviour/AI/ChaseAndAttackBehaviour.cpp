@@ -2,72 +2,68 @@
 
 #include "../../Entity/EntityManager.h"
 #include "../../Entity/UI/StatusUIEntity.h"
-#include "../../UI/NotificationMessageRenderer.h"
+#include "../../Intents.h"
 #include "HostilityBehaviour.h"
 #include "WanderAttachBehaviour.h"
 
-void ChaseAndAttackBehaviour::tick() {
+void ChaseAndAttackBehaviour::plan(Intents &intents) {
     // get the status UI and set the player's attack target to the parent entity
-    auto &ui = dynamic_cast<StatusUIEntity &>(*EntityManager::getInstance().getEntityByID("StatusUI"));
-    ui.setAttackTarget(mParent.mID);
+    intents.then([this] {
+        auto &ui = dynamic_cast<StatusUIEntity &>(*EntityManager::getInstance().getEntityByID("StatusUI"));
+        ui.setAttackTarget(mParent.mID);
+    });
 
-    auto &player = *EntityManager::getInstance().getEntityByID("Player");
-    Point posOffset;
-
-    // move towards the player by 1 step
-    if (player.getPos().mX > mParent.getPos().mX)
-        posOffset.mX = 1;
-    else if (player.getPos().mX < mParent.getPos().mX)
-        posOffset.mX = -1;
-    if (player.getPos().mY > mParent.getPos().mY)
-        posOffset.mY = 1;
-    else if (player.getPos().mY < mParent.getPos().mY)
-        posOffset.mY = -1;
+    // the flow field to the player is shared by all chasing entities
+    const auto &flowField = EntityManager::getInstance().getPlayerFlowField();
+    Point playerPos = flowField.getTarget();
+    Point nextPos = flowField.getNextStep(mParent.getPos());
 
     // if we are more than 1 square away from the player
-    if (mParent.getPos() + posOffset != player.getPos()) {
+    if (nextPos != playerPos) {
         // if we are more than `range` away from the player
-        if (mParent.getPos().distanceTo(player.getPos()) > range) {
-            double r = randDouble();
+        if (mParent.getPos().distanceSquaredTo(playerPos) > range * range) {
+            double r = mParent.mRandom.nextDouble();
             // if we roll less than the unattachment probability
             if (r < unattachment) {
                 // disable this behaviour
                 mEnabled = false;
-
-                // re-enable wandering
-                if (mParent.getBehaviourByID("WanderBehaviour") != nullptr) {
-                    mParent.getBehaviourByID("WanderBehaviour")->enable();
-                }
-                // re-enable WanderAttach but don't attach anymore
-                if (mParent.getBehaviourByID("WanderAttachBehaviour") != nullptr) {
-                    auto &wanderAttach =
-                        dynamic_cast<WanderAttachBehaviour &>(*mParent.getBehaviourByID("WanderAttachBehaviour"));
-                    wanderAttach.onlyWander = true; // Never attach to player anymore
-                    wanderAttach.enable();
-                }
-                // re-enable the hostility behaviour
-                if (mParent.getBehaviourByID("HostilityBehaviour") != nullptr) {
-                    mParent.getBehaviourByID("HostilityBehaviour")->enable();
-                }
-                // else add a hostility behaviour
-                else if (postHostility != 0) { // Don't bother adding hostility if it won't ever be triggered
-                    mParent.addBehaviour(
-                        std::make_unique<HostilityBehaviour>(mParent, postHostilityRange, postHostility));
-                }
+                intents.then([this] { stopChasing(); });
             }
         }
 
         // if we roll less than clinginess, move towards the player
-        if (randDouble() < clinginess)
-            mParent.moveTo(mParent.getPos() + posOffset);
+        if (mParent.mRandom.nextDouble() < clinginess)
+            intents.moveTo(nextPos);
         return;
     }
 
     // Attack the player
+    auto &player = *EntityManager::getInstance().getEntityByID("Player");
     int damage = mParent.rollDamage();
-    player.mHp -= damage;
+    intents.attack(player, damage);
 
     // Send a notification logging the attack
-    NotificationMessageRenderer::getInstance().queueMessage(
-        mParent.mGraphic + " " + mParent.mName + " $[white]hit you for ${black}$[red]" + std::to_string(damage));
+    intents.notify(mParent.mGraphic + " " + mParent.mName + " $[white]hit you for ${black}$[red]" +
+                   std::to_string(damage));
+}
+
+void ChaseAndAttackBehaviour::stopChasing() {
+    // re-enable wandering
+    if (mParent.getBehaviourByID("WanderBehaviour") != nullptr) {
+        mParent.getBehaviourByID("WanderBehaviour")->enable();
+    }
+    // re-enable WanderAttach but don't attach anymore
+    if (mParent.getBehaviourByID("WanderAttachBehaviour") != nullptr) {
+        auto &wanderAttach = dynamic_cast<WanderAttachBehaviour &>(*mParent.getBehaviourByID("WanderAttachBehaviour"));
+        wanderAttach.onlyWander = true; // Never attach to player anymore
+        wanderAttach.enable();
+    }
+    // re-enable the hostility behaviour
+    if (mParent.getBehaviourByID("HostilityBehaviour") != nullptr) {
+        mParent.getBehaviourByID("HostilityBehaviour")->enable();
+    }
+    // else add a hostility behaviour
+    else if (postHostility != 0) { // Don't bother adding hostility if it won't ever be triggered
+        mParent.addBehaviour(std::make_unique<HostilityBehaviour>(mParent, postHostilityRange, postHostility));
+    }
 }
@@ -7,6 +7,8 @@
 /// then re-enable that, otherwise if postHostility != 0 it will create a new "HostilityBehaviour" with parameters
 /// postHostilityRange and postHostility
 struct ChaseAndAttackBehaviour : Behaviour {
+    POOLED_ALLOCATION(ChaseAndAttackBehaviour)
+
     /// Initialize the behaviour
     /// \param parent parent of this behaviour
     /// \param clinginess probability of moving towards the player on tick
@@ -24,5 +26,9 @@ struct ChaseAndAttackBehaviour : Behaviour {
     float range;
     float postHostilityRange;
     float postHostility;
-    void tick() override;
+    void plan(Intents &intents) override;
+
+  private:
+    /// Go back to wandering and possibly become hostile, after the behaviour has been disabled
+    void stopChasing();
 };
@@ -1,8 +1,10 @@
 #include "HostilityBehaviour.h"
 
 #include "../../Entity/EntityManager.h"
-#include "../../UI/NotificationMessageRenderer.h"
-#include "../../utils.h"
+#include "../../Intents.h"
+
+#include <algorithm>
+#include <cmath>
 
 HostilityBehaviour::HostilityBehaviour(Entity &parent, float range, float hostility)
     : Behaviour("HostilityBehaviour", parent), range(range), hostility(hostility) {
@@ -11,17 +13,29 @@ HostilityBehaviour::HostilityBehaviour(Entity &parent, float range, float hostil
                                     " as it does not have a ChaseAndAttackBehaviour");
 }
 
-void HostilityBehaviour::tick() {
+void HostilityBehaviour::plan(Intents &intents) {
     auto chaseAndAttack = mParent.getBehaviourByID("ChaseAndAttackBehaviour");
     auto player = EntityManager::getInstance().getEntityByID("Player");
 
-    if (chaseAndAttack != nullptr && !chaseAndAttack->isEnabled() && player != nullptr && randDouble() < hostility &&
-        mParent.getPos().distanceTo(player->getPos()) < range) {
+    // Already attacking, the chase re-enables this behaviour when it gives up
+    if (chaseAndAttack == nullptr || chaseAndAttack->isEnabled() || player == nullptr) {
+        sleepUntilWoken();
+        return;
+    }
+
+    // The player and the parent can each move at most one cell per tick (diagonally at worst), so the gap closes by less
+    // than three cells a tick. Sleep until the player could possibly be in range
+    auto distance = std::sqrt(static_cast<float>(mParent.getPos().distanceSquaredTo(player->getPos())));
+    if (distance >= range) {
+        sleepFor(std::max(1ul, static_cast<unsigned long>((distance - range) / 3)));
+        return;
+    }
+
+    if (mParent.mRandom.nextDouble() < hostility) {
         mParent.disableWanderBehaviours();
 
         // Send a notification notifying the player they're engaged in attack
-        NotificationMessageRenderer::getInstance().queueMessage("${black}The $[red]" + mParent.mName +
-                                                                " $[white]went $[red]feral!");
-        chaseAndAttack->enable();
+        intents.notify("${black}The $[red]" + mParent.mName + " $[white]went $[red]feral!");
+        intents.then([chaseAndAttack] { chaseAndAttack->enable(); });
     }
 }
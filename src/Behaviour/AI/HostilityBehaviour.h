@@ -4,6 +4,8 @@
 
 /// Chase and attack the player if in range
 struct HostilityBehaviour : Behaviour {
+    POOLED_ALLOCATION(HostilityBehaviour)
+
     /// Initialize the behaviour. Will throw exception if entity has no "ChaseAndAttackBehaviour"
     /// \param parent parent entity of this behaviour
     /// \param range range in which to consider attacking
@@ -12,5 +14,5 @@ struct HostilityBehaviour : Behaviour {
 
     float range;
     float hostility; // in [0, 1]
-    void tick() override;
+    void plan(Intents &intents) override;
 };
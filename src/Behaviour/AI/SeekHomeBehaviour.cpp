@@ -2,24 +2,21 @@
 
 #include "../../Entity/Entity.h"
 #include "../../Entity/EntityManager.h"
-#include "../../utils.h"
+#include "../../Intents.h"
 
-void SeekHomeBehaviour::tick() {
-    if (homeTargetID.empty() && randDouble() < homeAttachmentProbability) {
-        // nb: this is only the entities on the screens surrounding the player
-        std::vector<Entity *> entities = EntityManager::getInstance().getEntitiesOnScreenAndSurroundingScreens();
-
-        // filter for home entities that have the specified name and are in range
-        entities.erase(std::remove_if(entities.begin(), entities.end(),
-                                      [this](Entity *entity) {
-                                          return !(entity->mName == homeName &&
-                                                   entity->getPos().distanceTo(mParent.getPos()) < range);
-                                      }),
-                       entities.end());
+void SeekHomeBehaviour::plan(Intents &intents) {
+    if (homeTargetID.empty()) {
+        // find home entities that have the specified name and are in range
+        EntityManager::getInstance().queryEntitiesInRadius(mParent.getPos(), range, homeTag, candidateHomes);
 
         // pick one of these home entities at random to set as target
-        if (!entities.empty()) {
-            homeTargetID = entities[rand() % entities.size()]->mID;
+        if (!candidateHomes.empty()) {
+            auto index = mParent.mRandom.nextBelow(static_cast<uint32_t>(candidateHomes.size()));
+            homeTargetID = candidateHomes[index]->mID;
+        } else {
+            // sleep until the next tick we would have rolled to look for a home on
+            sleepFor(1 + static_cast<unsigned long>(mParent.mRandom.nextGeometric(homeAttachmentProbability)));
+            return;
         }
     }
 
@@ -30,7 +27,7 @@ void SeekHomeBehaviour::tick() {
         Entity *homeTarget = EntityManager::getInstance().getEntityByID(homeTargetID);
         if (homeTarget == nullptr) {
             homeTargetID.clear();
-            mParent.enableWanderBehaviours();
+            intents.then([this] { mParent.enableWanderBehaviours(); });
             return;
         }
 
@@ -38,32 +35,22 @@ void SeekHomeBehaviour::tick() {
 
         // if we are at the target home, stop moving towards it
         if (targetPos == mParent.getPos()) {
-            isInHome = true;
-
-            // random chance to leave the home and start wandering again
-            if (randDouble() < homeFlightProbability) {
-                homeTargetID.clear();
-                mParent.enableWanderBehaviours();
+            // random chance to leave the home and start wandering again, rolled ahead of time so that we can sleep in
+            // the home until then
+            if (!isInHome) {
+                isInHome = true;
+                sleepFor(1 + static_cast<unsigned long>(mParent.mRandom.nextGeometric(homeFlightProbability)));
+                return;
             }
 
+            homeTargetID.clear();
+            intents.then([this] { mParent.enableWanderBehaviours(); });
+            sleepFor(1 + static_cast<unsigned long>(mParent.mRandom.nextGeometric(homeAttachmentProbability)));
             return;
         }
 
         isInHome = false;
 
-        Point posOffset;
-
-        if (targetPos.mX > mParent.getPos().mX) {
-            posOffset.mX = 1;
-        } else if (targetPos.mX < mParent.getPos().mX) {
-            posOffset.mX = -1;
-        }
-        if (targetPos.mY > mParent.getPos().mY) {
-            posOffset.mY = 1;
-        } else if (targetPos.mY < mParent.getPos().mY) {
-            posOffset.mY = -1;
-        }
-
-        mParent.moveTo(mParent.getPos() + posOffset);
+        intents.moveTo(EntityManager::getInstance().getNextStepTowards(mParent, targetPos));
     }
 }
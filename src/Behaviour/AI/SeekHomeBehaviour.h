@@ -1,11 +1,15 @@
 #pragma once
 
+#include "../../Tag.h"
 #include "../Behaviour.h"
 #include <string>
+#include <vector>
 
 /// Seek out a Home entity (identified by given name) if nearby and hole up within it
 /// with chance of leaving the home again
 struct SeekHomeBehaviour : Behaviour {
+    POOLED_ALLOCATION(SeekHomeBehaviour)
+
     /// Name of home entities to go to
     std::string homeName;
     /// Range within which to start moving to the home entity
@@ -20,13 +24,18 @@ struct SeekHomeBehaviour : Behaviour {
     explicit SeekHomeBehaviour(Entity &parent, std::string homeName, float range = 20,
                                float homeAttachmentProbability = 0.1, float homeFlightProbability = 0.1)
         : Behaviour("SeekHomeBehaviour", parent), homeName(std::move(homeName)), range(range),
-          homeAttachmentProbability(homeAttachmentProbability), homeFlightProbability(homeFlightProbability) {}
+          homeAttachmentProbability(homeAttachmentProbability), homeFlightProbability(homeFlightProbability),
+          homeTag(internTag(this->homeName)) {}
 
-    void tick() override;
+    void plan(Intents &intents) override;
 
     const std::string &getHomeID() const { return homeTargetID; }
 
   private:
     /// ID of current home target
     std::string homeTargetID;
+    /// homeName interned
+    Tag homeTag;
+    /// Homes in range, kept between ticks to avoid allocating
+    std::vector<Entity *> candidateHomes;
 };
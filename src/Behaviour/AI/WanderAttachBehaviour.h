@@ -1,10 +1,12 @@
 #pragma once
-#include "../../utils.h"
+#include "../../Entity/Entity.h"
 #include "AttachmentBehaviour.h"
 #include "WanderBehaviour.h"
 
 /// Combination of a WanderBehaviour and AttachBehaviour, with a random probability to go from wander to attach
 struct WanderAttachBehaviour : Behaviour {
+    POOLED_ALLOCATION(WanderAttachBehaviour)
+
     WanderBehaviour wander;
     AttachmentBehaviour attach;
     /// Only wander, don't attach
@@ -24,26 +26,29 @@ struct WanderAttachBehaviour : Behaviour {
     WanderAttachBehaviour(Entity &parent, float attachment, float clinginess, float unattachment)
         : WanderAttachBehaviour(parent, attachment, clinginess, unattachment, 10) {}
 
-    void tick() override {
+    void plan(Intents &intents) override {
         if (onlyWander) {
-            wander.tick();
+            wander.wanderRandomly(intents);
             return;
         }
 
-        double r = randDouble();
+        double r = mParent.mRandom.nextDouble();
 
         // If attached, wander OR follow not both at once
         if (attach.attached) {
             if (r < attach.clinginess) {
-                attach.tick();
+                attach.plan(intents);
             } else {
-                wander.tick();
+                wander.wanderRandomly(intents);
             }
         } else {
             // decide whether to reattach...
-            attach.tick();
+            attach.plan(intents);
             // ...then wander
-            wander.tick();
+            wander.wanderRandomly(intents);
         }
     }
+
+    /// Drift as the wander behaviour would, as an entity away from the player has nothing to attach to
+    void catchUp(unsigned long ticks, Span<Entity *> screen) override { wander.catchUp(ticks, screen); }
 };
\ No newline at end of file
@@ -1,10 +1,28 @@
 #include "WanderBehaviour.h"
 #include "../../Entity/Entity.h"
+#include "../../Intents.h"
 #include "../../Point.h"
+#include "../../World.h"
 
-void WanderBehaviour::tick() {
+#include <algorithm>
+#include <cmath>
+
+constexpr double WanderBehaviour::STEP_PROBABILITY;
+
+void WanderBehaviour::plan(Intents &intents) {
+    step(intents);
+    // Skip the ticks that would have rolled not to move
+    sleepFor(1 + static_cast<unsigned long>(mParent.mRandom.nextGeometric(STEP_PROBABILITY)));
+}
+
+void WanderBehaviour::wanderRandomly(Intents &intents) {
+    if (mParent.mRandom.nextDouble() < STEP_PROBABILITY)
+        step(intents);
+}
+
+void WanderBehaviour::step(Intents &intents) {
     Point p = mParent.getPos();
-    switch (rand() % 20) {
+    switch (mParent.mRandom.nextBelow(8)) {
     case 0:
         p.mX++;
         break;
@@ -35,5 +53,26 @@ void WanderBehaviour::tick() {
         break;
     }
 
-    mParent.moveTo(p);
-}
\ No newline at end of file
+    intents.moveTo(p);
+}
+void WanderBehaviour::catchUp(unsigned long ticks, Span<Entity *> screen) {
+    // Each step moves -1, 0 or 1 along an axis with variance 3/4, so after n steps the displacement along each axis is
+    // close to normally distributed with variance 3n/4
+    const double steps = STEP_PROBABILITY * static_cast<double>(ticks);
+    const double spread = std::sqrt(0.75 * steps);
+    Point p = mParent.getPos() + Point(static_cast<int>(std::lround(spread * mParent.mRandom.nextGaussian())),
+                                       static_cast<int>(std::lround(spread * mParent.mRandom.nextGaussian())));
+
+    // Stay on the same screen, which is the only one being caught up
+    const Point origin = World::worldPosToWorld(mParent.getWorldPos());
+    p.mX = std::min(std::max(p.mX, origin.mX), origin.mX + World::SCREEN_WIDTH - 1);
+    p.mY = std::min(std::max(p.mY, origin.mY), origin.mY + World::SCREEN_HEIGHT - 1);
+    if (p == mParent.getPos())
+        return;
+
+    for (auto entity : screen) {
+        if (entity != &mParent && entity->collide(p))
+            return;
+    }
+    mParent.teleportTo(p);
+}
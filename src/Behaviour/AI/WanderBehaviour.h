@@ -4,6 +4,23 @@
 
 /// This behaviour causes the parent entity to wander aimlessly in every direction
 struct WanderBehaviour : Behaviour {
+    POOLED_ALLOCATION(WanderBehaviour)
+
+    /// Probability of taking a step on each tick
+    static constexpr double STEP_PROBABILITY = 0.4;
+
     explicit WanderBehaviour(Entity &parent) : Behaviour("WanderBehaviour", parent) {}
-    void tick() override;
+    /// Take a step, then sleep until the next tick that we would have rolled to take a step on
+    void plan(Intents &intents) override;
+
+    /// Take a step with probability STEP_PROBABILITY, for behaviours that wander on every tick
+    void wanderRandomly(Intents &intents);
+
+    /// Drift to where the parent would be likely to have wandered to in ticks ticks, staying on its screen. Stays put
+    /// if that cell is blocked
+    void catchUp(unsigned long ticks, Span<Entity *> screen) override;
+
+  private:
+    /// Step to one of the eight surrounding cells at random
+    void step(Intents &intents);
 };
@@ -0,0 +1,30 @@
+#include "Behaviour.h"
+
+#include "../Entity/EntityManager.h"
+#include "../Intents.h"
+
+void Behaviour::plan(Intents &intents) { intents.then([this] { tick(); }); }
+
+void Behaviour::enable() {
+    mEnabled = true;
+    wake();
+}
+
+void Behaviour::sleepFor(unsigned long ticks) {
+    // The EntityManager schedules the parent to wake once all of its behaviours are asleep
+    mWakeTick = EntityManager::getInstance().getTickCount() + (ticks > 0 ? ticks : 1);
+    mSleepingUntilWoken = false;
+}
+
+void Behaviour::sleepUntilWoken() { mSleepingUntilWoken = true; }
+
+void Behaviour::wake() {
+    mWakeTick = 0;
+    mSleepingUntilWoken = false;
+    if (mParent.mIsManaged)
+        EntityManager::getInstance().wakeEntity(mParent);
+}
+
+bool Behaviour::isAwake() const {
+    return !mSleepingUntilWoken && EntityManager::getInstance().getTickCount() >= mWakeTick;
+}
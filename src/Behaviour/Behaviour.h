@@ -1,7 +1,10 @@
 #pragma once
 
+#include "../ObjectPool.h"
+#include "../Span.h"
 #include <string>
 
+class Intents;
 struct Entity;
 /// Describes a behaviour that can be attached to an Entity and can update on each tick of the game loop
 struct Behaviour {
@@ -15,19 +18,49 @@ struct Behaviour {
     /// Mutable reference to the parent
     Entity &mParent;
 
-    /// Called each engine tick, called by the parent entity
-    virtual void tick() {};
+    /// Decide what to do this tick, called by the parent entity on each engine tick that the behaviour is awake. Runs in
+    /// parallel with the behaviours of other entities, so may only change the parent and its behaviours, must draw
+    /// random numbers from the parent's mRandom, and must leave every other change to the world to intents. By default
+    /// defers to tick() once it is safe to change the world
+    /// \param intents changes to apply once every entity has planned
+    virtual void plan(Intents &intents);
 
-    /// Handle a specific int signal, not really used right now
-    virtual void handle(uint32_t /*signal*/) {};
+    /// Called when the intents of the parent are applied, for behaviours that do not override plan(). By default the
+    /// behaviour has nothing to do so sleeps until woken
+    virtual void tick() { sleepUntilWoken(); };
+
+    /// Apply the overall effect of ticks ticks that the parent's screen was not simulated for, see
+    /// SimulationLOD. Behaviours that only wait for a tick to come round need not override this
+    /// \param ticks number of ticks missed
+    /// \param screen the other entities on the parent's screen, to check for collisions
+    virtual void catchUp(unsigned long /*ticks*/, Span<Entity *> /*screen*/) {}
 
     /// Is the Behaviour enabled? Can override in subclasses
     virtual bool isEnabled() const { return mEnabled; }
 
-    void enable() { mEnabled = true; }
+    /// Enable the behaviour, waking it so that it ticks on the next tick
+    void enable();
 
     void disable() { mEnabled = false; }
 
+    /// Don't tick the behaviour for the given number of ticks, or until it is woken
+    /// \param ticks number of ticks to sleep for, at least 1
+    void sleepFor(unsigned long ticks);
+    /// Don't tick the behaviour again until it is woken, e.g. by the parent taking damage or its inventory changing
+    void sleepUntilWoken();
+    /// Cancel any sleep so that the behaviour ticks on the next tick
+    void wake();
+    /// Should the behaviour be ticked on the current tick?
+    bool isAwake() const;
+    /// Get the tick at which the current sleepFor() ends, or 0 if the behaviour is not sleeping for a set time
+    unsigned long getWakeTick() const { return mSleepingUntilWoken ? 0 : mWakeTick; }
+
   protected:
     bool mEnabled{true};
+
+  private:
+    /// Tick at which a sleepFor() ends
+    unsigned long mWakeTick{0};
+    /// Is the behaviour waiting to be woken?
+    bool mSleepingUntilWoken{false};
 };
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Behaviour.h"
-#include <SDL3/SDL.h>
+#include "../KeyEvent.h"
 
 struct Font;
 // TODO: This should be a property, but difficult due to virtual methods
@@ -10,9 +10,9 @@ struct InteractableBehaviour : Behaviour {
     explicit InteractableBehaviour(Entity &parent) : Behaviour("InteractableBehaviour", parent) {}
 
     /// Handle input from the player entity. If it returns false then the interaction with the player will end.
-    /// \param e the raw SDL keyboard event
+    /// \param e the key pressed
     /// \return if false, end the current interaction
-    virtual bool handleInput(SDL_KeyboardEvent &e) { return false; }
+    virtual bool handleInput(KeyEvent &e) { return false; }
 
     /// Allows custom rendering to be done by the behaviour if required
     virtual void render(Font &) {}
@@ -4,6 +4,8 @@
 // TODO: enemies should be able to use it to heal themselves
 /// Represents an item that heals the player, not exceeding their maximum health
 struct HealingItemBehaviour : ApplyableBehaviour {
+    POOLED_ALLOCATION(HealingItemBehaviour)
+
     /// Initialize the behaviour
     /// \param parent parent entity
     /// \param healingAmount amount to heal the player
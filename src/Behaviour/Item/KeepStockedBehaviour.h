@@ -10,21 +10,44 @@
 /// Also, T must be an Entity that has a constructor with no arguments
 template <typename T> class KeepStockedBehaviour : public Behaviour {
     const int restockRate;
-    int ticksUntilRestock;
+    /// Earliest tick at which the inventory can be restocked
+    unsigned long restockTick;
 
   public:
+    // No member depends on T, so every instantiation is the same size and they can all share one pool
+    POOLED_ALLOCATION_FROM(KeepStockedBehaviour<Entity>, "KeepStockedBehaviour")
+
     KeepStockedBehaviour(Entity &parent, int restockRate)
-        : Behaviour("KeepStockedBehaviour", parent), restockRate(restockRate), ticksUntilRestock(restockRate) {}
+        : Behaviour("KeepStockedBehaviour", parent), restockRate(restockRate),
+          restockTick(EntityManager::getInstance().getTickCount() + restockRate) {}
 
+    /// Restock if the inventory is empty and the restock time has been reached, then sleep until the next restock
+    /// time or, if the inventory is still stocked, until the parent's inventory changes
     void tick() override {
-        if (ticksUntilRestock == 0 && mParent.isInventoryEmpty()) {
+        auto now = EntityManager::getInstance().getTickCount();
+        restockIfDue(now);
+
+        if (now < restockTick)
+            sleepFor(restockTick - now);
+        else
+            sleepUntilWoken();
+    }
+
+    /// Restock if the restock time passed while the parent's screen was not simulated. Only one item is ever stocked,
+    /// so this is the same as having ticked throughout
+    void catchUp(unsigned long /*ticks*/, Span<Entity *> /*screen*/) override {
+        restockIfDue(EntityManager::getInstance().getTickCount());
+    }
+
+  private:
+    /// Restock if the inventory is empty and the restock time has been reached
+    void restockIfDue(unsigned long now) {
+        if (now >= restockTick && mParent.isInventoryEmpty()) {
             auto item = std::make_unique<T>();
             auto ID = item->mID;
             EntityManager::getInstance().addEntity(std::move(item));
             mParent.addToInventory(ID);
-            ticksUntilRestock = restockRate;
+            restockTick = now + restockRate;
         }
-        if (ticksUntilRestock > 0)
-            --ticksUntilRestock;
     }
 };
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <SDL3/SDL.h>
+#include <cstdint>
 
 #include <string>
 #include <unordered_map>
@@ -8,18 +8,18 @@
 /// rgba color structure
 struct Color {
     Color() : r(0xFF), g(0xFF), b(0xFF), a(0xFF) {}
-    Color(Uint8 r, Uint8 g, Uint8 b) : Color(r, g, b, 0xFF) {}
-    Color(Uint8 r, Uint8 g, Uint8 b, Uint8 a) : r(r), g(g), b(b), a(a) {}
+    Color(uint8_t r, uint8_t g, uint8_t b) : Color(r, g, b, 0xFF) {}
+    Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a) : r(r), g(g), b(b), a(a) {}
 
-    Uint8 r;
-    Uint8 g;
-    Uint8 b;
-    Uint8 a;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
 
     friend Color operator*(Color lhs, float l) {
-        lhs.r = (Uint8)((float)lhs.r * l);
-        lhs.g = (Uint8)((float)lhs.g * l);
-        lhs.b = (Uint8)((float)lhs.b * l);
+        lhs.r = (uint8_t)((float)lhs.r * l);
+        lhs.g = (uint8_t)((float)lhs.g * l);
+        lhs.b = (uint8_t)((float)lhs.b * l);
         return lhs;
     }
 
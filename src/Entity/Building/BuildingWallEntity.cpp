@@ -1,6 +1,8 @@
 #include "BuildingWallEntity.h"
 #include "../../Color.h"
+#include "../../FieldOfView.h"
 #include "../../Font.h"
+#include "../../OccupancyGrid.h"
 #include "../../World.h"
 #include "../EntityManager.h"
 #include "DoorEntity.h"
@@ -86,6 +88,8 @@ void BuildingWallEntity::generateWallsFromPoints(const std::unordered_set<Point>
 }
 
 void BuildingWallEntity::render(Font &font, Point currentWorldPos) {
+    const auto &fov = EntityManager::getInstance().getFieldOfView();
+
     // Only draw if the entity is on the current world screen
     if (isOnScreen(currentWorldPos)) {
         // draw each wall tile
@@ -94,6 +98,11 @@ void BuildingWallEntity::render(Font &font, Point currentWorldPos) {
             Point screenPos = World::worldToScreen(mPos + wallPos);
             WallType wallType = pair.second;
 
+            // Walls that are out of sight are drawn greyed out if the player remembers them
+            bool isVisible = fov.isVisible(mPos + wallPos);
+            if (!isVisible && !fov.hasSeen(mPos + wallPos))
+                continue;
+
             std::string c; // the character we will draw
 
             // choose the correct fontstring character for each wall type. Here we choose the double-thickness pipe
@@ -134,7 +143,7 @@ void BuildingWallEntity::render(Font &font, Point currentWorldPos) {
                 break;
             }
 
-            font.draw(c, screenPos, Color::getColor("white"), Color::getColor("black"));
+            font.draw(c, screenPos, Color::getColor(isVisible ? "white" : "grey"), Color::getColor("black"));
         }
     }
 }
@@ -144,4 +153,9 @@ bool BuildingWallEntity::collide(const Point &pos) {
     Point wallPos = pos - mPos;
     // check if this point is in mWalls
     return mWalls.find(wallPos) != mWalls.cend();
-}
\ No newline at end of file
+}
+
+void BuildingWallEntity::markOccupancy(OccupancyGrid &grid) const {
+    for (const auto &pair : mWalls)
+        grid.mark(mPos + pair.first, OCCUPANCY_OPAQUE | OCCUPANCY_SOLID);
+}
@@ -6,6 +6,8 @@
 /// Generates a set of walls for a building from a layout string.
 /// The walls and corners are automatically detected to use the corresponding double-thickness pipe characters.
 struct BuildingWallEntity : Entity {
+    POOLED_ALLOCATION(BuildingWallEntity)
+
     /// Initialize a new building position entity from a layout string
     /// e.g.
     /// std::vector<std::string> layout = {
@@ -31,6 +33,13 @@ struct BuildingWallEntity : Entity {
     /// \return whether or not collision occurred
     bool collide(const Point &pos) override;
 
+    /// Every wall tile blocks both light and movement
+    /// \param grid the occupancy grid to mark
+    void markOccupancy(OccupancyGrid &grid) const override;
+
+    /// Always drawn, as each wall tile is drawn according to whether it is visible or remembered
+    bool isVisibleIn(const FieldOfView & /*fov*/) const override { return true; }
+
     /// The different allowed wall types
     enum class WallType : int {
         UL_CORNER, // corner with adjacent walls above and to the left
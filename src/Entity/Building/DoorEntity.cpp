@@ -1,6 +1,9 @@
 #include "DoorEntity.h"
 
+#include "../../FieldOfView.h"
+#include "../../OccupancyGrid.h"
 #include "../../UI/NotificationMessageRenderer.h"
+#include "../EntityManager.h"
 
 DoorEntity::DoorEntity(const Point &pos) : Entity("", "Door", "") {
     mPos = pos;
@@ -10,7 +13,7 @@ DoorEntity::DoorEntity(const Point &pos) : Entity("", "Door", "") {
     addBehaviour(std::move(interactable));
 }
 
-bool DoorEntity::DoorOpenAndCloseBehaviour::handleInput(SDL_KeyboardEvent &) {
+bool DoorEntity::DoorOpenAndCloseBehaviour::handleInput(KeyEvent &) {
     std::string message;
     auto &parent = dynamic_cast<DoorEntity &>(mParent);
 
@@ -41,3 +44,20 @@ bool DoorEntity::collide(const Point &pos) {
     }
     return false;
 }
+
+bool DoorEntity::isVisibleIn(const FieldOfView &fov) const { return fov.hasSeen(mPos); }
+
+void DoorEntity::markOccupancy(OccupancyGrid &grid) const {
+    if (!mIsOpen)
+        grid.mark(mPos, OCCUPANCY_OPAQUE);
+}
+
+void DoorEntity::open() {
+    mIsOpen = true;
+    EntityManager::getInstance().invalidateOccupancy();
+}
+
+void DoorEntity::close() {
+    mIsOpen = false;
+    EntityManager::getInstance().invalidateOccupancy();
+}
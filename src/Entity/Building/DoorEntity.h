@@ -5,6 +5,8 @@
 
 /// Represents a door that can be opened or closed with spacebar
 struct DoorEntity : Entity {
+    POOLED_ALLOCATION(DoorEntity)
+
     explicit DoorEntity(const Point &pos);
 
     /// Overrides rendering to display whether the door is open or closed
@@ -17,15 +19,24 @@ struct DoorEntity : Entity {
     /// \return whether or not collision occurred
     bool collide(const Point &pos) override;
 
-    void open() { mIsOpen = true; }
-    void close() { mIsOpen = false; }
+    /// A closed door blocks light but not movement, as walking into it opens it
+    /// \param grid the occupancy grid to mark
+    void markOccupancy(OccupancyGrid &grid) const override;
+
+    /// Doors are part of the building, so stay drawn once seen
+    bool isVisibleIn(const FieldOfView &fov) const override;
+
+    void open();
+    void close();
     bool isOpen() { return mIsOpen; }
 
     /// Handles the opening and closing of the door with spacebar
     struct DoorOpenAndCloseBehaviour : InteractableBehaviour {
+        POOLED_ALLOCATION(DoorOpenAndCloseBehaviour)
+
         explicit DoorOpenAndCloseBehaviour(Entity &parent) : InteractableBehaviour(parent) {}
 
-        bool handleInput(SDL_KeyboardEvent &e) override;
+        bool handleInput(KeyEvent &e) override;
     };
 
   private:
@@ -3,5 +3,7 @@
 #include "Entity.h"
 
 struct BunnyHoleEntity : Entity {
+    POOLED_ALLOCATION(BunnyHoleEntity)
+
     explicit BunnyHoleEntity() : Entity("", "Bunny's House", "o") {}
 };
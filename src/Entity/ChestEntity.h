@@ -3,6 +3,8 @@
 #include "Entity.h"
 
 struct ChestEntity : Entity {
+    POOLED_ALLOCATION(ChestEntity)
+
     const std::string SHORT_DESC = "A heavy wooden chest";
     const std::string LONG_DESC = "This chest is super heavy";
 
@@ -1,7 +1,13 @@
 #include "Entity.h"
+#include "../AllocationCounter.h"
 #include "../Behaviour/Behaviour.h"
+#include "../FieldOfView.h"
 #include "../Font.h"
+#include "../Intents.h"
+#include "../Lighting/LightRegistry.h"
+#include "../OccupancyGrid.h"
 #include "../Point.h"
+#include "../Profiler.h"
 #include "../Property/Properties/AdditionalCarryWeightProperty.h"
 #include "../Property/Properties/CraftingMaterialProperty.h"
 #include "../Property/Properties/EquippableProperty.h"
@@ -10,6 +16,7 @@
 #include "../World.h"
 #include "EntityManager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -20,9 +27,13 @@ Entity::Entity(std::string ID, std::string name, std::string graphic, float hp,
     : mHp(hp), mMaxHp(maxhp), mRegenPerTick(regenPerTick), mHitTimes(hitTimes), mHitAmount(hitAmount),
       mID(std::move(ID)), mName(std::move(name)), mGraphic(std::move(graphic)), mPos(0, 0),
       mMaxCarryWeight(maxCarryWeight) {
-    // If we specify an empty string generate a random ID
+    // If we specify an empty string generate a random ID, wide enough that worlds of millions of entities are unlikely
+    // to ever roll the same one twice
+    auto &random = RandomStreams::getInstance();
     if (this->mID.empty())
-        this->mID = std::to_string(rand());
+        this->mID = std::to_string(random.getStream(RandomStream::ENTITY_IDS).next64());
+    mRandom = random.makeStream(RandomStream::AI, this->mID);
+    mCombatRandom = random.makeStream(RandomStream::COMBAT, this->mID);
     // Add 1 to number of existing entities
     gNumInitialisedEntities++;
 
@@ -38,23 +49,64 @@ Entity::Entity(std::string ID, std::string name, std::string graphic, float hp,
 
 void Entity::addBehaviour(std::unique_ptr<Behaviour> behaviour) { mBehaviours[behaviour->mID] = std::move(behaviour); }
 
+void Entity::plan(Intents &intents) {
+    ALLOCATION_ZONE("Entity::plan");
+    for (auto &behaviour : mBehaviours) {
+        if (behaviour.second->isEnabled() && behaviour.second->isAwake()) {
+            PROFILE_ZONE_DYNAMIC(behaviour.second->mID);
+            behaviour.second->plan(intents);
+        }
+    }
+}
+
 void Entity::tick() {
     if (mHp < mMaxHp)
         mHp += mRegenPerTick;
 
     if (mHp > mMaxHp)
         mHp = mMaxHp;
+}
+
+void Entity::catchUp(unsigned long ticks, Span<Entity *> screen) {
+    if (mHp < mMaxHp)
+        mHp += mRegenPerTick * static_cast<float>(ticks);
+
+    if (mHp > mMaxHp)
+        mHp = mMaxHp;
 
     for (auto &behaviour : mBehaviours) {
         if (behaviour.second->isEnabled())
-            behaviour.second->tick();
+            behaviour.second->catchUp(ticks, screen);
     }
 }
 
-void Entity::emit(Uint32 signal) {
-    for (auto &behaviour : mBehaviours) {
-        behaviour.second->handle(signal);
+void Entity::wake() {
+    for (auto &behaviour : mBehaviours)
+        behaviour.second->wake();
+    if (mIsManaged)
+        EntityManager::getInstance().wakeEntity(*this);
+}
+
+bool Entity::isIdle() const {
+    // Still regenerating health
+    if (!canSleep() || (mRegenPerTick > 0 && mHp < mMaxHp))
+        return false;
+
+    for (const auto &behaviour : mBehaviours) {
+        if (behaviour.second->isEnabled() && behaviour.second->isAwake())
+            return false;
+    }
+    return true;
+}
+
+unsigned long Entity::getWakeTick() const {
+    unsigned long wakeTick = 0;
+    for (const auto &behaviour : mBehaviours) {
+        auto behaviourWakeTick = behaviour.second->getWakeTick();
+        if (behaviour.second->isEnabled() && behaviourWakeTick != 0 && (wakeTick == 0 || behaviourWakeTick < wakeTick))
+            wakeTick = behaviourWakeTick;
     }
+    return wakeTick;
 }
 
 void Entity::render(Font &font, Point currentWorldPos) {
@@ -79,6 +131,13 @@ bool Entity::isOnScreen(const Point &currentWorldPos) {
 
 bool Entity::collide(const Point &pos) { return mIsSolid && mPos == pos; }
 
+bool Entity::isVisibleIn(const FieldOfView &fov) const { return fov.isVisible(mPos); }
+
+void Entity::markOccupancy(OccupancyGrid &grid) const {
+    if (mIsSolid && !mIsInAnInventory)
+        grid.mark(mPos, OCCUPANCY_OPAQUE | OCCUPANCY_SOLID);
+}
+
 Behaviour *Entity::getBehaviourByID(const std::string &ID) const {
     if (mBehaviours.find(ID) == mBehaviours.cend())
         return nullptr;
@@ -101,7 +160,7 @@ int Entity::computeMaxDamage() const {
 int Entity::rollDamage() {
     int totalDamage = 0;
     for (int i = 0; i < mHitTimes; ++i) {
-        totalDamage += rand() % (computeMaxDamage() + 1);
+        totalDamage += static_cast<int>(mCombatRandom.nextBelow(static_cast<uint32_t>(computeMaxDamage() + 1)));
     }
     return totalDamage;
 }
@@ -120,6 +179,7 @@ bool Entity::addToInventory(const std::string &ID) {
         mInventory.push_back(item->mID);
         item->mShouldRender = false;
         item->mIsInAnInventory = true;
+        wake();
         return true;
     } else {
         throw std::invalid_argument("item does not have Pickuppable property");
@@ -128,9 +188,13 @@ bool Entity::addToInventory(const std::string &ID) {
 
 void Entity::removeFromInventory(const std::string &ID) {
     mInventory.erase(std::remove(mInventory.begin(), mInventory.end(), ID), mInventory.end());
+    wake();
 }
 
-void Entity::removeFromInventory(int inventoryIndex) { mInventory.erase(mInventory.begin() + inventoryIndex); }
+void Entity::removeFromInventory(int inventoryIndex) {
+    mInventory.erase(mInventory.begin() + inventoryIndex);
+    wake();
+}
 
 void Entity::dropItem(int inventoryIndex) {
     auto item = EntityManager::getInstance().getEntityByID(mInventory[inventoryIndex]);
@@ -139,6 +203,7 @@ void Entity::dropItem(int inventoryIndex) {
     item->mShouldRender = true;
     item->mIsInAnInventory = false;
     item->setPos(mPos);
+    wake();
 }
 
 Entity *Entity::getInventoryItem(int inventoryIndex) const {
@@ -206,21 +271,25 @@ bool Entity::moveTo(Point p) {
 
     // Check that there were no collisions in the space
     if (entities.empty()) {
-        Point oldWorldPos = getWorldPos();
-        setPos(p);
-        // Check if we moved to a new world coordinate, if so update the current entities on screen
-        if (oldWorldPos != getWorldPos())
-            em.recomputeCurrentEntitiesOnScreenAndSurroundingScreens();
-
-        // Also move all items held by entity
-        for (const std::string &ID : mInventory)
-            em.getEntityByID(ID)->setPos(p);
-
+        teleportTo(p);
         return true;
     }
     return false;
 }
 
+void Entity::teleportTo(Point p) {
+    auto &em = EntityManager::getInstance();
+    Point oldWorldPos = getWorldPos();
+    setPos(p);
+    // Check if we moved to a new world coordinate, if so update the current entities on screen
+    if (oldWorldPos != getWorldPos())
+        em.recomputeCurrentEntitiesOnScreenAndSurroundingScreens();
+
+    // Also move all items held by entity
+    for (const std::string &ID : mInventory)
+        em.getEntityByID(ID)->setPos(p);
+}
+
 const std::unordered_map<EquipmentSlot, std::string> &Entity::getEquipment() const { return mEquipment; }
 
 bool Entity::equip(EquipmentSlot slot, Entity *entity) {
@@ -357,7 +426,16 @@ void Entity::addProperty(std::unique_ptr<Property> property) { mProperties[prope
 
 void Entity::setPos(int x, int y) { setPos(Point(x, y)); }
 
-void Entity::setPos(Point p) { mPos = p; }
+void Entity::setPos(Point p) {
+    Point oldPos = mPos;
+    Point oldWorldPos = getWorldPos();
+    mPos = p;
+    if (mIsManaged)
+        EntityManager::getInstance().onEntityMoved(*this, oldPos);
+    // Lights are indexed by the screen that they are on
+    if (oldWorldPos != getWorldPos())
+        LightRegistry::getInstance().onEntityChangedWorldPos(*this);
+}
 
 Point Entity::getPos() const { return mPos; }
 
@@ -3,8 +3,12 @@
 #define ENTITY_H_
 
 #include "../Behaviour/Behaviour.h"
+#include "../ObjectPool.h"
 #include "../Point.h"
 #include "../Property/Property.h"
+#include "../Random.h"
+#include "../Span.h"
+#include "../Tag.h"
 #include "EquipmentSlot.h"
 #include <memory>
 #include <stdexcept>
@@ -15,7 +19,10 @@
 /// Tracks the number of initialised entities in the game
 extern int gNumInitialisedEntities;
 
+class FieldOfView;
 class Font;
+class Intents;
+class OccupancyGrid;
 struct World;
 /// Base entity class for all entities in the game (including player)
 struct Entity {
@@ -51,6 +58,8 @@ struct Entity {
 
     virtual ~Entity() = default;
 
+    POOLED_ALLOCATION(Entity)
+
     float mHp;           /// Current hp of the entity
     float mMaxHp;        /// Maximum hp of the entity
     float mRegenPerTick; /// How much hp to regen per tick
@@ -70,6 +79,11 @@ struct Entity {
     float mQuality{1}; /// Quality as a crafting product
 
     std::string mName; /// Descriptive name
+    Tag mArchetype{NO_TAG}; /// mName interned when added to the EntityManager, for fast comparisons
+    bool mIsManaged{false}; /// Is the entity owned by the EntityManager?
+    bool mIsAwake{false};   /// Is the entity in the EntityManager's list of entities to tick?
+    Pcg32 mRandom;          /// Random numbers for the entity's behaviours, from its own AI stream
+    Pcg32 mCombatRandom;    /// Random numbers for the entity's damage rolls, from its own combat stream
     // TODO: virtual getter for mShortDesc, change based on quality?
     std::string mShortDesc; /// Short one-line description
     std::string mLongDesc;  /// Long paragraph description
@@ -81,15 +95,37 @@ struct Entity {
     /// Move the behaviour to the entities vector of behaviours
     virtual void addBehaviour(std::unique_ptr<Behaviour> behaviour);
 
-    /// Regen entity health and tick all Behaviours owned by entity
+    /// Plan all enabled Behaviours owned by entity that are awake. Runs in parallel with other entities, see
+    /// Behaviour::plan()
+    /// \param intents changes to the world to apply once every entity has planned
+    virtual void plan(Intents &intents);
+
+    /// Regen entity health. Called one entity at a time after every entity has planned, just before the entity's
+    /// intents are applied
     virtual void tick();
 
+    /// Apply the overall effect of ticks ticks that the entity's screen was not simulated for, by regenerating health
+    /// and catching up the enabled behaviours. Called one entity at a time, in order of ID, see SimulationLOD
+    /// \param ticks number of ticks missed
+    /// \param screen the entities on the same screen, including this one
+    virtual void catchUp(unsigned long ticks, Span<Entity *> screen);
+
+    /// Wake the entity and all of its behaviours, so that it is ticked on the next tick
+    void wake();
+
+    /// Can the entity stop being ticked once all of its behaviours are asleep? Entities that do work in tick() itself
+    /// should return false
+    virtual bool canSleep() const { return true; }
+
+    /// Can the EntityManager stop ticking the entity until one of its behaviours is due to wake?
+    bool isIdle() const;
+
+    /// Get the earliest tick at which one of the enabled behaviours wakes from sleepFor(), or 0 if none of them will
+    unsigned long getWakeTick() const;
+
     /// Remove entity from the entity manager
     virtual void destroy();
 
-    /// Emit signal to all subentities
-    virtual void emit(uint32_t signal);
-
     /// Render the entity to the screen using font, taking current world position into account
     /// \param font to render using
     /// \param currentWorldPos the current screen grid coordinates on the world grid
@@ -100,6 +136,10 @@ struct Entity {
     /// \return whether or not is on screen
     bool isOnScreen(const Point &currentWorldPos);
 
+    /// Should the entity be drawn given what the player can see? By default only if its position is visible
+    /// \param fov the player's field of view
+    virtual bool isVisibleIn(const FieldOfView &fov) const;
+
     /// Handle collision with `pos`, returning true if collision occurred.
     /// Default interpretation is whether `pos == this->getPos()`
     virtual bool collide(const Point &pos);
@@ -107,6 +147,10 @@ struct Entity {
     /// Handles collision but is also given a reference to the entity that is colliding
     virtual bool collide(const Point &, Entity &) { return false; }
 
+    /// Mark the cells this entity blocks in the occupancy grid. By default a solid entity is opaque and solid at its
+    /// position
+    virtual void markOccupancy(OccupancyGrid &grid) const;
+
     /// Add entity with ID to inventory
     virtual bool addToInventory(const std::string &ID);
     /// Remove entity with given ID from inventory
@@ -159,6 +203,9 @@ struct Entity {
     /// \param p Point to move to
     /// \return Whether or not the movement was performed
     bool moveTo(Point p);
+    /// Move to Point p without checking for collisions, also moving the entity's inventory and recomputing the current
+    /// screen's entities if it changes screen coords
+    void teleportTo(Point p);
 
     /// Get behaviour with given ID
     Behaviour *getBehaviourByID(const std::string &ID) const;
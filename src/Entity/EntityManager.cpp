@@ -1,30 +1,45 @@
 #include "EntityManager.h"
 
+#include "../EventBus.h"
 #include "../Font.h"
 #include "../LightMapPoint.h"
-#include "../LightMapTexture.h"
+#include "../Lighting/LightRegistry.h"
 #include "../Property/Properties/LightEmittingProperty.h"
+#include "../JobSystem.h"
+#include "../Profiler.h"
+#include "../Random.h"
 #include "../World.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 
+EntityManager::EntityManager() {
+    // Entities unregister their lights when they are destroyed, so make sure the registry is constructed first and
+    // hence outlives the entities
+    LightRegistry::getInstance();
+}
+
 void EntityManager::addEntity(std::unique_ptr<Entity> entity) {
     if (getEntityByID(entity->mID) != nullptr)
         throw std::invalid_argument("Entity with ID " + entity->mID + " already present!");
 
+    entity->mArchetype = internTag(entity->mName);
+    entity->mIsManaged = true;
+    mSpatialIndex.insert(entity.get());
+    mSimulationLOD.addScreen(entity->getWorldPos(), mTickCount);
+    wakeEntity(*entity);
+
     mEntities[entity->mID] = std::move(entity);
+    invalidateOccupancy();
 
     // Make sure new entities trigger a refresh of the render order list and entity caches
     if (!mToRender.empty())
         recomputeCurrentEntitiesOnScreenAndSurroundingScreens(getEntityByID("Player")->getWorldPos());
 }
 
-void EntityManager::broadcast(Uint32 signal) {
-    for (const auto &entity : mEntities) {
-        entity.second->emit(signal);
-    }
-}
-
 #define UNMANAGED_ENTITIES_ERROR_MESSAGE                                                                               \
     "Warning! The number of initialised entities is not equal to the number of entities in the entity manager!"
 
@@ -36,41 +51,177 @@ void EntityManager::initialize() {
 }
 
 void EntityManager::tick() {
+    PROFILE_ZONE("EntityManager::tick");
+    ALLOCATION_ZONE("EntityManager::tick");
+    using Clock = std::chrono::steady_clock;
+    auto secondsSince = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    auto phaseStart = Clock::now();
+    const auto allocationsAtStart = getAllocationCounts();
+
+    // Scratch data from the last tick, such as query results, is no longer needed
+    Arena::resetTickArenas();
+    // Deliver the events published since the last tick, e.g. by the player's input, while the entities they name
+    // still exist
+    EventBus::getInstance().dispatch();
     cleanup();
 
+    ++mTickCount;
     mTimeOfDay += mTimePerTick;
+    mPlayerFlowFieldDirty = true;
+    // Forget the paths of entities that stopped following them during the last tick
+    mPathfinder.prune();
 
     if ((size_t)gNumInitialisedEntities != mEntities.size())
         std::cerr << UNMANAGED_ENTITIES_ERROR_MESSAGE << std::endl;
 
-    // Only update entities in this screen and surrounding screens
-    // TODO: add special type of entity that always keeps updated e.g. the player's farm
-    for (const auto &ID : mCurrentlyOnScreen)
-        getEntityByID(ID)->tick();
-    for (const auto &ID : mInSurroundingScreens)
-        getEntityByID(ID)->tick();
+    // Wake the entities whose behaviours asked to sleep until this tick
+    mTimerWheel.advance(mTickCount, mDue);
+    for (const auto &ID : mDue) {
+        auto entity = getEntityByID(ID);
+        if (entity != nullptr)
+            wakeEntity(*entity);
+    }
+    mDue.clear();
+    mLastTickTimings.mWake = secondsSince(phaseStart);
+    phaseStart = Clock::now();
+
+    // Bring the screens that are not ticked in full up to date, as often as their distance from the player allows
+    auto playerWorldPos = getEntityByID("Player")->getWorldPos();
+    mSimulationLOD.update(mTickCount, playerWorldPos, mCatchUps);
+    mLastTickTimings.mNumCaughtUp = 0;
+    for (const auto &catchUp : mCatchUps)
+        mLastTickTimings.mNumCaughtUp += catchUpScreen(catchUp.mWorldPos, catchUp.mTicks);
+    // Entities may have moved while catching up
+    if (!mCatchUps.empty())
+        invalidateOccupancy();
+    mLastTickTimings.mCatchUp = secondsSince(phaseStart);
+    phaseStart = Clock::now();
+
+    // Only update awake entities in this screen and surrounding screens. Entities elsewhere are dropped from the awake
+    // list and are woken again when the player comes near, having been caught up in the meantime
+    std::swap(mAwake, mTicking);
+    mTickingEntities.clear();
+    for (const auto &ID : mTicking) {
+        auto entity = getEntityByID(ID);
+        if (entity == nullptr)
+            continue;
+        entity->mIsAwake = false;
+
+        auto worldPosDiff = entity->getWorldPos() - playerWorldPos;
+        if (std::abs(worldPosDiff.mX) > 1 || std::abs(worldPosDiff.mY) > 1)
+            continue;
+        mTickingEntities.push_back(entity);
+    }
+    mTicking.clear();
+
+    // Bring the shared views of the world up to date so that planning only ever reads them
+    getOccupancy();
+    getPlayerFlowField();
+    mLastTickTimings.mPrepare = secondsSince(phaseStart);
+    mLastTickTimings.mNumTicked = mTickingEntities.size();
+    phaseStart = Clock::now();
+
+    if (mIntents.size() < mTickingEntities.size())
+        mIntents.resize(mTickingEntities.size());
+    {
+        PROFILE_ZONE("EntityManager::tick plan");
+        ALLOCATION_ZONE("EntityManager::tick plan");
+        JobSystem::getInstance().parallelFor(mTickingEntities.size(),
+                                             [this](size_t i) { mTickingEntities[i]->plan(mIntents[i]); });
+    }
+    mLastTickTimings.mPlan = secondsSince(phaseStart);
+    phaseStart = Clock::now();
+
+    {
+        PROFILE_ZONE("EntityManager::tick apply");
+        ALLOCATION_ZONE("EntityManager::tick apply");
+        for (size_t i = 0; i < mTickingEntities.size(); ++i) {
+            mTickingEntities[i]->tick();
+            mIntents[i].apply(*mTickingEntities[i]);
+        }
+    }
+    // Deliver the events published while applying intents, so that they are shown before the next frame
+    EventBus::getInstance().dispatch();
+    mLastTickTimings.mApply = secondsSince(phaseStart);
+    phaseStart = Clock::now();
+
+    for (auto entity : mTickingEntities) {
+        // Keep ticking the entity until all of its behaviours have gone to sleep, then wake it when the first of them
+        // is due
+        if (!entity->isIdle())
+            wakeEntity(*entity);
+        else if (!entity->mIsAwake && entity->getWakeTick() != 0)
+            mTimerWheel.schedule(entity->getWakeTick(), entity->mID);
+    }
+
+    // Entities may have moved or changed during the tick
+    invalidateOccupancy();
+    mLastTickTimings.mSleep = secondsSince(phaseStart);
+    mLastTickTimings.mNumSpatialQueries = mNumSpatialQueries.exchange(0, std::memory_order_relaxed);
+
+    const auto allocations = getAllocationCounts();
+    mLastTickTimings.mAllocations.mAllocations = allocations.mAllocations - allocationsAtStart.mAllocations;
+    mLastTickTimings.mAllocations.mBytes = allocations.mBytes - allocationsAtStart.mBytes;
 }
 
-void EntityManager::render(Font &font, Point currentWorldPos, LightMapTexture &lightMapTexture) {
-    for (const auto &a : mToRender) {
-        getEntityByID(a.first)->render(font, currentWorldPos);
-    }
+size_t EntityManager::catchUpScreen(const Point &worldPos, unsigned long ticks) {
+    PROFILE_ZONE("EntityManager::catchUpScreen");
+    // Every cell of the screen is closer than this to its centre
+    const Point centre = World::worldPosToWorld(worldPos) + Point(World::SCREEN_WIDTH / 2, World::SCREEN_HEIGHT / 2);
+    const auto radius = static_cast<float>(std::hypot(World::SCREEN_WIDTH, World::SCREEN_HEIGHT) / 2 + 1);
+    queryEntitiesInRadius(centre, radius, NO_TAG, mCatchUpEntities);
+    auto onOtherScreen = [&worldPos](const Entity *entity) { return entity->getWorldPos() != worldPos; };
+    mCatchUpEntities.erase(std::remove_if(mCatchUpEntities.begin(), mCatchUpEntities.end(), onOtherScreen),
+                           mCatchUpEntities.end());
+
+    // The order of the spatial index depends on its history, so catch up in an order that doesn't
+    std::sort(mCatchUpEntities.begin(), mCatchUpEntities.end(),
+              [](const Entity *a, const Entity *b) { return a->mID < b->mID; });
+    for (auto entity : mCatchUpEntities)
+        entity->catchUp(ticks, Span<Entity *>(mCatchUpEntities));
+    return mCatchUpEntities.size();
+}
 
-    // Draw time-of-day fog
-    auto frac = EntityManager::getInstance().getTimeOfDay().getFractionOfDay();
+void EntityManager::wakeEntity(Entity &entity) {
+    if (entity.mIsAwake)
+        return;
+    entity.mIsAwake = true;
+    mAwake.push_back(entity.mID);
+}
+
+float EntityManager::getDarkness() const {
+    auto frac = getTimeOfDay().getFractionOfDay();
     auto a = 0.6 + 0.8 * std::sin(2 * M_PI * frac - M_PI / 2);
     if (a < 0)
         a = 0;
     else if (a > 1)
         a = 1;
-    auto alpha = static_cast<Uint8>(a * 0xFF);
-    lightMapTexture.render(getLightSources(font.getCellSize()), alpha);
+    return static_cast<float>(a);
 }
 
-void EntityManager::render(Font &font, LightMapTexture &lightMapTexture) {
-    render(font, getEntityByID("Player")->getWorldPos(), lightMapTexture);
+void EntityManager::updateFieldOfView() {
+    getLightSources(mLightSources);
+    // Past half darkness the player can only see what is lit
+    mFieldOfView.update(getOccupancy(), getEntityByID("Player")->getPos(), getDarkness() > 0.5f, mLightSources);
 }
 
+uint8_t EntityManager::getLightMapAlpha() const { return static_cast<uint8_t>(getDarkness() * 0xFF); }
+
+void EntityManager::render(Font &font, Point currentWorldPos) {
+    PROFILE_ZONE("EntityManager::render");
+    ALLOCATION_ZONE("EntityManager::render");
+    for (const auto &a : mToRender) {
+        auto entity = getEntityByID(a.first);
+        // Never draw what the player cannot see
+        if (entity->isVisibleIn(mFieldOfView))
+            entity->render(font, currentWorldPos);
+    }
+}
+
+void EntityManager::render(Font &font) { render(font, getEntityByID("Player")->getWorldPos()); }
+
 Entity *EntityManager::getEntityByID(const std::string &ID) const {
     if (mEntities.find(ID) == mEntities.cend())
         return nullptr;
@@ -78,6 +229,7 @@ Entity *EntityManager::getEntityByID(const std::string &ID) const {
 }
 
 std::vector<Entity *> EntityManager::getEntitiesAtPos(const Point &pos) const {
+    countSpatialQuery();
     std::vector<Entity *> entitiesAtPos;
 
     for (const auto &entity : mEntities) {
@@ -88,8 +240,10 @@ std::vector<Entity *> EntityManager::getEntitiesAtPos(const Point &pos) const {
     return entitiesAtPos;
 }
 
-std::vector<Entity *> EntityManager::getEntitiesAtPosFaster(const Point &pos) const {
-    std::vector<Entity *> entitiesAtPos;
+Span<Entity *> EntityManager::getEntitiesAtPosFaster(const Point &pos, Arena &arena) const {
+    ALLOCATION_ZONE("EntityManager::getEntitiesAtPosFaster");
+    countSpatialQuery();
+    ArenaVector<Entity *> entitiesAtPos{ArenaAllocator<Entity *>(arena)};
 
     // TODO: remove ugly double loop
     for (const auto &ID : mInSurroundingScreens) {
@@ -101,10 +255,12 @@ std::vector<Entity *> EntityManager::getEntitiesAtPosFaster(const Point &pos) co
             entitiesAtPos.push_back(getEntityByID(ID));
     }
 
-    return entitiesAtPos;
+    // The arena keeps the elements after the vector is destroyed
+    return Span<Entity *>(entitiesAtPos);
 }
 
 std::vector<Entity *> EntityManager::getEntitiesSurrounding(const Point &pos) const {
+    countSpatialQuery();
     std::vector<Entity *> entitiesSurrounding;
     const std::vector<Point> surroundingPoints{pos + Point(-1, 0), pos + Point(1, 0),   pos + Point(0, -1),
                                                pos + Point(0, 1),  pos + Point(-1, -1), pos + Point(-1, 1),
@@ -119,11 +275,13 @@ std::vector<Entity *> EntityManager::getEntitiesSurrounding(const Point &pos) co
     return entitiesSurrounding;
 }
 
-std::vector<Entity *> EntityManager::getEntitiesSurroundingFaster(const Point &pos) const {
-    std::vector<Entity *> entitiesSurrounding;
-    const std::vector<Point> surroundingPoints{pos + Point(-1, 0), pos + Point(1, 0),   pos + Point(0, -1),
-                                               pos + Point(0, 1),  pos + Point(-1, -1), pos + Point(-1, 1),
-                                               pos + Point(1, -1), pos + Point(1, 1)};
+Span<Entity *> EntityManager::getEntitiesSurroundingFaster(const Point &pos, Arena &arena) const {
+    ALLOCATION_ZONE("EntityManager::getEntitiesSurroundingFaster");
+    countSpatialQuery();
+    ArenaVector<Entity *> entitiesSurrounding{ArenaAllocator<Entity *>(arena)};
+    const std::array<Point, 8> surroundingPoints{{pos + Point(-1, 0), pos + Point(1, 0), pos + Point(0, -1),
+                                                  pos + Point(0, 1), pos + Point(-1, -1), pos + Point(-1, 1),
+                                                  pos + Point(1, -1), pos + Point(1, 1)}};
 
     // TODO: remove ugly double loop
     for (const auto &ID : mInSurroundingScreens) {
@@ -137,7 +295,7 @@ std::vector<Entity *> EntityManager::getEntitiesSurroundingFaster(const Point &p
             entitiesSurrounding.emplace_back(getEntityByID(ID));
     }
 
-    return entitiesSurrounding;
+    return Span<Entity *>(entitiesSurrounding);
 }
 
 std::vector<Entity *> EntityManager::getEntitiesOnScreenAndSurroundingScreens() const {
@@ -152,6 +310,7 @@ std::vector<Entity *> EntityManager::getEntitiesOnScreenAndSurroundingScreens()
 }
 
 std::vector<Entity *> EntityManager::doCollisions(const Point &pos, Entity &entity) {
+    countSpatialQuery();
     std::vector<Entity *> collidingEntities;
     for (const auto &ID : mCurrentlyOnScreen) {
         Entity *e = getEntityByID(ID);
@@ -167,6 +326,18 @@ std::vector<Entity *> EntityManager::doCollisions(const Point &pos, Entity &enti
     return collidingEntities;
 }
 
+uint64_t EntityManager::computeStateHash() const {
+    // Sum the hashes of the entities so that the result does not depend on the iteration order of mEntities
+    uint64_t entitiesHash = 0;
+    for (const auto &pair : mEntities) {
+        const Entity &entity = *pair.second;
+        const Point pos = entity.getPos();
+        entitiesHash += hashSeed(entity.mID + "|" + std::to_string(pos.mX) + "," + std::to_string(pos.mY) + "|" +
+                                 std::to_string(entity.mHp) + "|" + std::to_string(entity.getInventorySize()));
+    }
+    return hashSeed(std::to_string(entitiesHash) + "|" + std::to_string(mTickCount) + "|" + mTimeOfDay.toString());
+}
+
 void EntityManager::cleanup() {
     while (!mToBeDeleted.empty()) {
         eraseByID(mToBeDeleted.front());
@@ -174,11 +345,36 @@ void EntityManager::cleanup() {
     }
 }
 
+void EntityManager::clear() {
+    gNumInitialisedEntities -= static_cast<int>(mEntities.size());
+    mEntities.clear();
+    std::queue<std::string>().swap(mToBeDeleted);
+    mCurrentlyOnScreen.clear();
+    mInSurroundingScreens.clear();
+    mToRender.clear();
+    mLightSources.clear();
+    mSpatialIndex = SpatialIndex();
+    mTimerWheel = TimerWheel();
+    mSimulationLOD.clear();
+    mAwake.clear();
+    mHasTickWindow = false;
+    invalidateOccupancy();
+    mPlayerFlowFieldDirty = true;
+}
+
 void EntityManager::queueForDeletion(const std::string &ID) { mToBeDeleted.push(ID); }
 
 void EntityManager::eraseByID(const std::string &ID) {
+    auto entity = getEntityByID(ID);
+    if (entity != nullptr) {
+        mSpatialIndex.remove(entity);
+        // Don't leave the ID in the awake list, in case another entity is added with the same ID
+        if (entity->mIsAwake)
+            mAwake.erase(std::remove(mAwake.begin(), mAwake.end(), ID), mAwake.end());
+    }
     mEntities.erase(ID);
     --gNumInitialisedEntities;
+    invalidateOccupancy();
     recomputeCurrentEntitiesOnScreenAndSurroundingScreens(getEntityByID("Player")->getWorldPos());
 }
 
@@ -191,6 +387,19 @@ void EntityManager::reorderEntities() {
     std::sort(mToRender.begin(), mToRender.end(), [](auto &a, auto &b) { return a.second > b.second; });
 }
 
+void EntityManager::queryEntitiesInRadius(const Point &center, float radius, Tag tag,
+                                          std::vector<Entity *> &out) const {
+    countSpatialQuery();
+    mSpatialIndex.query(center, radius, tag, out);
+}
+
+void EntityManager::onEntityMoved(Entity &entity, const Point &oldPos) {
+    mSpatialIndex.move(&entity, oldPos);
+    // Entities can wander onto screens that nothing was generated on
+    if (entity.getWorldPos() != Point(oldPos.mX / World::SCREEN_WIDTH, oldPos.mY / World::SCREEN_HEIGHT))
+        mSimulationLOD.addScreen(entity.getWorldPos(), mTickCount);
+}
+
 bool EntityManager::isEntityInManager(const std::string &ID) { return mEntities.find(ID) != mEntities.end(); }
 
 // TODO should split this into two separate functions for current entities on screen and for surrounding screens
@@ -206,6 +415,17 @@ void EntityManager::recomputeCurrentEntitiesOnScreenAndSurroundingScreens(Point
             mInSurroundingScreens.emplace_back(a.second->mID);
     }
     reorderEntities();
+    invalidateOccupancy();
+
+    // Entities that were out of range of the player went to sleep, so wake everything when the player changes screen
+    if (!mHasTickWindow || currentWorldPos != mTickWindow) {
+        mTickWindow = currentWorldPos;
+        mHasTickWindow = true;
+        for (const auto &ID : mCurrentlyOnScreen)
+            wakeEntity(*getEntityByID(ID));
+        for (const auto &ID : mInSurroundingScreens)
+            wakeEntity(*getEntityByID(ID));
+    }
 }
 
 const Time &EntityManager::getTimeOfDay() const { return mTimeOfDay; }
@@ -216,22 +436,57 @@ const Time &EntityManager::getTimePerTick() const { return mTimePerTick; }
 
 void EntityManager::setTimePerTick(const Time &timePerTick) { EntityManager::mTimePerTick = timePerTick; }
 
-std::vector<LightMapPoint> EntityManager::getLightSources(Point fontSize) const {
-    std::vector<LightMapPoint> points;
-
-    for (const auto &a : mCurrentlyOnScreen) {
-        const auto &entity = getEntityByID(a);
-        auto b = entity->getProperty<LightEmittingProperty>();
-        if (b != nullptr) {
-            if (b->isEnabled()) {
-                auto radius = fontSize.mY * b->getRadius();
-                auto point = fontSize * World::worldToScreen(entity->getPos()) + fontSize / 2;
-                points.emplace_back(point, radius, b->getColor());
-            }
-        }
+const OccupancyGrid &EntityManager::getOccupancy() {
+    if (!mOccupancyDirty)
+        return mOccupancy;
+
+    auto origin = World::worldPosToWorld(getEntityByID("Player")->getWorldPos() - Point(1, 1));
+    mOccupancyScratch.reset(origin, 3 * World::SCREEN_WIDTH, 3 * World::SCREEN_HEIGHT);
+    for (const auto &ID : mCurrentlyOnScreen)
+        getEntityByID(ID)->markOccupancy(mOccupancyScratch);
+    for (const auto &ID : mInSurroundingScreens)
+        getEntityByID(ID)->markOccupancy(mOccupancyScratch);
+
+    // Only bumps the revision if something actually changed, keeping cached light visibility valid
+    mOccupancy.assign(mOccupancyScratch);
+    mOccupancyDirty = false;
+    return mOccupancy;
+}
+
+const FlowField &EntityManager::getPlayerFlowField() {
+    if (mPlayerFlowFieldDirty) {
+        mPlayerFlowField.compute(getOccupancy(), getEntityByID("Player")->getPos());
+        mPlayerFlowFieldDirty = false;
+    }
+    return mPlayerFlowField;
+}
+
+Point EntityManager::getNextStepTowards(const Entity &entity, const Point &goal) {
+    if (goal == getEntityByID("Player")->getPos())
+        return getPlayerFlowField().getNextStep(entity.getPos());
+    return mPathfinder.getNextStep(entity.mID, entity.getPos(), goal, getOccupancy());
+}
+
+void EntityManager::getLightSources(std::vector<LightMapPoint> &points) {
+    points.clear();
+    const auto &occupancy = getOccupancy();
+
+    const auto &lights = LightRegistry::getInstance().getLightsAtWorldPos(getEntityByID("Player")->getWorldPos());
+    for (const auto b : lights) {
+        const auto entity = b->getParent();
+        // Skip lights that are not enabled, give no light (such as a burnt out fire) or whose entities are not yet
+        // managed
+        if (!b->isEnabled() || b->getRadius() <= 0 || !isEntityInManager(entity->mID))
+            continue;
+
+        // The light kernel is wider in cells than it is tall, so cast shadows out to its horizontal extent
+        auto radius = static_cast<int>(std::ceil(b->getRadius() * static_cast<float>(CHAR_HEIGHT) / CHAR_WIDTH));
+        auto visibility = mLightVisibility.get(entity->mID, entity->getPos(), radius, occupancy);
+        points.emplace_back(World::worldToScreen(entity->getPos()), b->getRadius(), b->getColor(),
+                            std::move(visibility));
     }
 
-    return points;
+    mLightVisibility.prune();
 }
 
 void EntityManager::recomputeCurrentEntitiesOnScreenAndSurroundingScreens() {
@@ -1,14 +1,49 @@
 #pragma once
 
+#include "../AllocationCounter.h"
+#include "../Arena.h"
+#include "../FieldOfView.h"
+#include "../FlowField.h"
+#include "../Intents.h"
+#include "../LightMapPoint.h"
+#include "../Lighting/LightVisibilityCache.h"
+#include "../OccupancyGrid.h"
+#include "../Pathfinder.h"
+#include "../SimulationLOD.h"
+#include "../SpatialIndex.h"
 #include "../Time.h"
+#include "../TimerWheel.h"
 #include "Entity.h"
 
+#include <atomic>
 #include <queue>
 #include <unordered_map>
 #include <vector>
 
-struct LightMapPoint;
-class LightMapTexture;
+/// Wall-clock time in seconds spent in each phase of an EntityManager::tick()
+struct TickTimings {
+    /// Removing deleted entities and waking the entities that are due
+    double mWake{0};
+    /// Catching up the screens away from the player, see SimulationLOD
+    double mCatchUp{0};
+    /// Picking the awake entities near the player and bringing the occupancy and flow field up to date
+    double mPrepare{0};
+    /// Planning, in parallel
+    double mPlan{0};
+    /// Ticking each entity and applying its intents
+    double mApply{0};
+    /// Putting idle entities to sleep
+    double mSleep{0};
+    /// Number of entities ticked
+    size_t mNumTicked{0};
+    /// Number of entities caught up
+    size_t mNumCaughtUp{0};
+    /// Number of spatial queries made since the previous tick finished, including this tick's
+    uint64_t mNumSpatialQueries{0};
+    /// Allocations made by every thread during the tick
+    AllocationCounts mAllocations;
+};
+
 /// Singleton class that manages all entities in the game
 class EntityManager {
     /// Map from the entity ID to a unique pointer owning the Entity instance
@@ -21,6 +56,57 @@ class EntityManager {
     std::vector<std::string> mInSurroundingScreens{};
     /// Vector of pairs of entity IDs to be rendered with their render ordering as ints
     std::vector<std::pair<std::string, int>> mToRender{};
+    /// Light sources on screen, refilled every frame by render() so that the storage is reused
+    std::vector<LightMapPoint> mLightSources{};
+
+    /// Opaque and solid cells of the current and surrounding screens
+    OccupancyGrid mOccupancy{};
+    /// Scratch grid that the occupancy is rebuilt into before being compared against mOccupancy
+    OccupancyGrid mOccupancyScratch{};
+    /// Does mOccupancy need to be rebuilt before it is next used?
+    bool mOccupancyDirty{true};
+    /// Shadowcast visibility of each light source on screen
+    LightVisibilityCache mLightVisibility{};
+    /// What the player can see and remembers seeing
+    FieldOfView mFieldOfView{};
+    /// Paths to the player for every chasing entity, computed at most once per tick
+    FlowField mPlayerFlowField{};
+    /// Does mPlayerFlowField need to be recomputed before it is next used?
+    bool mPlayerFlowFieldDirty{true};
+    /// Cached paths of entities heading anywhere other than the player
+    Pathfinder mPathfinder{};
+    /// Every managed entity bucketed by position
+    SpatialIndex mSpatialIndex{};
+
+    /// Number of ticks since the game started
+    unsigned long mTickCount{0};
+    /// Time spent in each phase of the last tick
+    TickTimings mLastTickTimings{};
+    /// Spatial queries made since the last tick finished. Queries are made while planning, so on several threads
+    mutable std::atomic<uint64_t> mNumSpatialQueries{0};
+    void countSpatialQuery() const { mNumSpatialQueries.fetch_add(1, std::memory_order_relaxed); }
+    /// Sleeping entities that asked to be woken at a later tick
+    TimerWheel mTimerWheel{};
+    /// How closely each screen is simulated, and the tick it is simulated up to
+    SimulationLOD mSimulationLOD{};
+    /// Screens to catch up this tick, kept between ticks to reuse the storage
+    std::vector<SimulationLOD::CatchUp> mCatchUps{};
+    /// Entities of the screen being caught up
+    std::vector<Entity *> mCatchUpEntities{};
+    /// IDs of the entities to tick on the next tick, each of which has mIsAwake set
+    std::vector<std::string> mAwake{};
+    /// The awake list being ticked, swapped with mAwake at the start of each tick to reuse the storage
+    std::vector<std::string> mTicking{};
+    /// Entities being ticked this tick, in the order that their intents are applied
+    std::vector<Entity *> mTickingEntities{};
+    /// Intents planned by each entity in mTickingEntities, kept between ticks to reuse the storage
+    std::vector<Intents> mIntents{};
+    /// IDs of the entities due to be woken this tick
+    std::vector<std::string> mDue{};
+    /// Player's world position when the current and surrounding screens were last recomputed
+    Point mTickWindow{};
+    /// Has mTickWindow been set yet?
+    bool mHasTickWindow{false};
 
     /// Current time of day the game
     Time mTimeOfDay{};
@@ -31,6 +117,13 @@ class EntityManager {
     /// fields
     void reorderEntities();
 
+    /// How dark it is given the time of day, from 0 (full daylight) to 1
+    float getDarkness() const;
+
+    /// Catch up the entities on the screen at worldPos, which missed ticks ticks, in order of ID
+    /// \return number of entities caught up
+    size_t catchUpScreen(const Point &worldPos, unsigned long ticks);
+
   public:
     /// Get the singleton instance
     static EntityManager &getInstance() {
@@ -38,7 +131,7 @@ class EntityManager {
         return instance;
     }
 
-    EntityManager() = default;
+    EntityManager();
     // Singleton, so delete copy constructor and copy assignment operator
     EntityManager(const EntityManager &) = delete;
     void operator=(const EntityManager &) = delete;
@@ -46,24 +139,60 @@ class EntityManager {
     /// Move the entity to be managed by the EntityManager, throwing an std::invalid_argument exception if entity with
     /// ID is already present
     void addEntity(std::unique_ptr<Entity> entity);
-    /// Broadcast the signal to all entities, which emit them to all behaviours
-    void broadcast(uint32_t signal);
     /// Checks if the number of entities in the entity manager equals the count of the number of entities initialized so
     /// far, printing a warning if they are not equal. Then calls recomputeCurrentEntitiesOnScreenAndSurroundingScreens
     /// with the player's world position
     void initialize();
-    /// cleanup() and then advance the game time, then tick all entities on this screen or the surrounding screens
-    /// (relative to the player)
+    /// cleanup() and then advance the game time, then tick the awake entities on this screen or the surrounding
+    /// screens (relative to the player). The entities first plan in parallel against the world as it was at the start
+    /// of the tick, then their intents are applied one entity at a time in the order the entities were woken. Entities
+    /// that are idle afterwards are not ticked again until they are woken. Queued events are delivered before
+    /// cleanup() and after the intents are applied. Before planning, the screens further away are caught up as
+    /// SimulationLOD decides
     void tick();
     /// Remove the entities in mToBeDeleted
     void cleanup();
+    /// Destroy every entity at once, without the per-entity bookkeeping of eraseByID(), e.g. between benchmark runs.
+    /// The tick count and time of day are kept
+    void clear();
+
+    /// Get the number of ticks since the game started
+    unsigned long getTickCount() const { return mTickCount; }
+    /// Get the time spent in each phase of the last tick
+    const TickTimings &getLastTickTimings() const { return mLastTickTimings; }
+    /// Tick the entity on the next tick, if it is on the current or surrounding screens
+    void wakeEntity(Entity &entity);
+    /// Hash the tick count, the time of day and the ID, position, hp and inventory size of every entity, so that two
+    /// runs of the game can be checked to have ended in the same state
+    uint64_t computeStateHash() const;
+
+    /// Get the flow field leading to the player over the current and surrounding screens, computing it if this is the
+    /// first time it has been asked for this tick
+    const FlowField &getPlayerFlowField();
 
-    /// Render the world and all entities to the font using the currentWorldPos,
-    /// also rendering all light sources using LightMapTexture with alpha
-    /// depending on time of day
-    void render(Font &font, Point currentWorldPos, LightMapTexture &lightMapTexture);
+    /// Get the position entity should move to next to get closer to goal, routing around solid cells. Paths to the
+    /// player use the shared flow field, other paths are found with A* and cached for the entity
+    /// \param entity the entity that is moving
+    /// \param goal world position to go to
+    /// \return position to move to, which is the entity's own position if it should wait
+    Point getNextStepTowards(const Entity &entity, const Point &goal);
+
+    /// Collect the light sources on the player's screen and bring the player's field of view up to date. Must be called
+    /// every frame before rendering
+    void updateFieldOfView();
+    /// Get the player's field of view, as of the last call to updateFieldOfView()
+    const FieldOfView &getFieldOfView() const { return mFieldOfView; }
+
+    /// Get the light sources on the player's screen, as of the last call to updateFieldOfView()
+    const std::vector<LightMapPoint> &getCurrentLightSources() const { return mLightSources; }
+    /// Get the alpha of the time-of-day fog to render the light map with
+    uint8_t getLightMapAlpha() const;
+
+    /// Render all entities visible to the player to the font using the currentWorldPos. Uses the field of view from
+    /// updateFieldOfView()
+    void render(Font &font, Point currentWorldPos);
     /// Same as other but uses the player's world position as currentWorldPos
-    void render(Font &font, LightMapTexture &lightMapTexture);
+    void render(Font &font);
 
     /// Get pointer to entity with ID, nullptr if it doesn't exist
     Entity *getEntityByID(const std::string &ID) const;
@@ -80,8 +209,11 @@ class EntityManager {
 
     /// Find entities at point `pos` searching only entities on the surrounding screens of player
     /// \param pos position to look at
-    /// \return vector of pointers to entities at pos
-    std::vector<Entity *> getEntitiesAtPosFaster(const Point &pos) const;
+    /// \param arena arena to put the results in: the calling thread's tick arena (Arena::getTickArena()) when called
+    /// during a tick, or its frame arena (Arena::getFrameArena()) when called between ticks, e.g. when handling input
+    /// or rendering, as the tick arena is only reset when a tick starts
+    /// \return pointers to entities at pos, valid until arena is reset
+    Span<Entity *> getEntitiesAtPosFaster(const Point &pos, Arena &arena) const;
 
     /// Find entities surrounding point `pos` WARNING SLOW (reads every entity)
     /// \param pos position to look around
@@ -90,8 +222,9 @@ class EntityManager {
 
     /// Find entities surrounding point `pos` searching only entities on the surrounding screens of player
     /// \param pos position to look around
-    /// \return vector of pointers to entities surrounding pos
-    std::vector<Entity *> getEntitiesSurroundingFaster(const Point &pos) const;
+    /// \param arena arena to put the results in, chosen as for getEntitiesAtPosFaster()
+    /// \return pointers to entities surrounding pos, valid until arena is reset
+    Span<Entity *> getEntitiesSurroundingFaster(const Point &pos, Arena &arena) const;
 
     /// Union of mCurrentlyOnScreen and mInSurroundingScreens
     /// \return vector of pointers to entities
@@ -103,6 +236,17 @@ class EntityManager {
     /// \return vector of pointers to all entities that collided
     std::vector<Entity *> doCollisions(const Point &pos, Entity &entity);
 
+    /// Find the entities with the given archetype (interned mName, or NO_TAG for any) strictly closer than radius to
+    /// center, not counting items inside inventories
+    /// \param center world position to search around
+    /// \param radius search radius in cells
+    /// \param tag archetype to match
+    /// \param out cleared and then filled with the matching entities, so that callers can reuse its storage
+    void queryEntitiesInRadius(const Point &center, float radius, Tag tag, std::vector<Entity *> &out) const;
+
+    /// Called by Entity::setPos to keep the spatial index up to date
+    void onEntityMoved(Entity &entity, const Point &oldPos);
+
     /// Is entity with ID registered in the manager?
     bool isEntityInManager(const std::string &ID);
 
@@ -127,9 +271,15 @@ class EntityManager {
     /// \param timePerTick increment per tick
     void setTimePerTick(const Time &timePerTick);
 
-    /// Get light sources on screen in screen-space coords.
-    /// Assumes that recomputeCurrentEntitiesOnScreen has been called to generate the vector of entities on screen
-    /// \param fontSize Point representing the width and height of each font cell
-    /// \return vector of light sources on screen
-    std::vector<LightMapPoint> getLightSources(Point fontSize) const;
+    /// Mark the occupancy grid as out of date, e.g. when an entity changes whether it blocks light
+    void invalidateOccupancy() { mOccupancyDirty = true; }
+    /// Get which cells of the current and surrounding screens are opaque or solid, rebuilding the grid if it has been
+    /// invalidated since it was last used
+    /// \return occupancy grid in world coordinates
+    const OccupancyGrid &getOccupancy();
+
+    /// Get light sources on the player's screen in screen cell coords, each with the cells it can reach past walls.
+    /// Only visits the lights registered on that screen in the LightRegistry
+    /// \param points cleared and then filled with the light sources on screen
+    void getLightSources(std::vector<LightMapPoint> &points);
 };
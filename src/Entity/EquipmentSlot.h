@@ -1,4 +1,5 @@
 #pragma once
+#include <string>
 #include <vector>
 
 /// Describes the different slots that equipment can be equipped in
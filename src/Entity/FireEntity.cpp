@@ -1,34 +1,59 @@
 #include "FireEntity.h"
 
-#include "../Property/Properties/LightEmittingProperty.h"
+#include "../OccupancyGrid.h"
+#include "../Random.h"
 #include "../UI/MessageBoxRenderer.h"
 #include "../UI/NotificationMessageRenderer.h"
 #include "EntityManager.h"
 
-FireEntity::FireEntity(std::string ID) : Entity(std::move(ID), "Fire", "") {
+#include <algorithm>
+#include <cmath>
+
+constexpr float FireEntity::DECAY_PER_TICK;
+const int FireEntity::MAX_LIGHT_RADIUS;
+constexpr double FireEntity::FLICKER_SECONDS;
+
+FireEntity::FireEntity(std::string ID)
+    : Entity(std::move(ID), "Fire", "${black}$[red]%"), mKindledTick(EntityManager::getInstance().getTickCount()),
+      mAnimation(*this) {
     mIsSolid = true;
-    addProperty(std::make_unique<LightEmittingProperty>(this, 6));
+    addProperty(std::make_unique<FireLightProperty>(this));
     addBehaviour(std::make_unique<RekindleBehaviour>(*this));
 }
 
-void FireEntity::render(Font &font, Point currentWorldPos) {
-    if (fireLevel < 0.1)
-        mGraphic = "${black}$[grey]%";
-    else if (rand() % 2 == 0)
-        mGraphic = "${black}$[red]%";
+void FireEntity::FlickerAnimation::update(double time) {
+    if (dynamic_cast<FireEntity &>(mParent).getFireLevel() < 0.1) {
+        mParent.mGraphic = "${black}$[grey]%";
+        return;
+    }
+    if (time < mNextFlickerTime)
+        return;
+
+    if (RandomStreams::getInstance().getStream(RandomStream::COSMETIC).nextBelow(2) == 0)
+        mParent.mGraphic = "${black}$[red]%";
     else
-        mGraphic = "${black}$[orange]%";
+        mParent.mGraphic = "${black}$[orange]%";
+    mNextFlickerTime = time + FLICKER_SECONDS;
+}
 
-    getProperty<LightEmittingProperty>()->setRadius(static_cast<int>(std::round(6 * fireLevel)));
+int FireEntity::FireLightProperty::getRadius() const {
+    auto fireLevel = dynamic_cast<const FireEntity *>(getParent())->getFireLevel();
+    // The fire level keeps falling once the fire has burnt out
+    return std::max(0, static_cast<int>(std::round(MAX_LIGHT_RADIUS * fireLevel)));
+}
 
-    Entity::render(font, currentWorldPos);
+float FireEntity::getFireLevel() const {
+    auto ticksSinceKindled = EntityManager::getInstance().getTickCount() - mKindledTick;
+    return 1 - DECAY_PER_TICK * static_cast<float>(ticksSinceKindled);
 }
 
-void FireEntity::tick() { fireLevel -= 0.005f; }
+void FireEntity::rekindle() { mKindledTick = EntityManager::getInstance().getTickCount(); }
+
+void FireEntity::markOccupancy(OccupancyGrid &grid) const { grid.mark(mPos, OCCUPANCY_SOLID); }
 
-bool FireEntity::RekindleBehaviour::handleInput(SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_J:
+bool FireEntity::RekindleBehaviour::handleInput(KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_J:
         if (choosingItemToUse) {
             const auto &player = EntityManager::getInstance().getEntityByID("Player");
             const auto &entities =
@@ -40,7 +65,7 @@ bool FireEntity::RekindleBehaviour::handleInput(SDL_KeyboardEvent &e) {
                 ++choosingItemIndex;
         }
         break;
-    case SDLK_K:
+    case KEY_K:
         if (choosingItemToUse) {
             const auto &player = EntityManager::getInstance().getEntityByID("Player");
             const auto &entities =
@@ -52,7 +77,7 @@ bool FireEntity::RekindleBehaviour::handleInput(SDL_KeyboardEvent &e) {
                 ++choosingItemIndex;
         }
         break;
-    case SDLK_RETURN:
+    case KEY_RETURN:
         if (!choosingItemToUse) {
             choosingItemToUse = true;
             break;
@@ -61,12 +86,12 @@ bool FireEntity::RekindleBehaviour::handleInput(SDL_KeyboardEvent &e) {
             const auto &entities =
                 player->filterInventoryForCraftingMaterials(std::vector<std::string>{"grass", "wood"});
             player->removeFromInventory(entities[choosingItemIndex]);
-            dynamic_cast<FireEntity &>(mParent).fireLevel = 1;
+            dynamic_cast<FireEntity &>(mParent).rekindle();
             NotificationMessageRenderer::getInstance().queueMessage("$[red]Rekindled fire");
             choosingItemToUse = false;
             return false;
         }
-    case SDLK_ESCAPE:
+    case KEY_ESCAPE:
         if (choosingItemToUse) {
             choosingItemToUse = false;
             choosingItemIndex = 0;
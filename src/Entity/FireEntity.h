@@ -1,13 +1,19 @@
 #pragma once
 
+#include "../Animation/Animation.h"
 #include "../Behaviour/InteractableBehaviour.h"
+#include "../Property/Properties/LightEmittingProperty.h"
 #include "Entity.h"
 
 struct FireEntity : Entity {
+    POOLED_ALLOCATION(FireEntity)
+
     struct RekindleBehaviour : InteractableBehaviour {
+        POOLED_ALLOCATION(RekindleBehaviour)
+
         explicit RekindleBehaviour(Entity &parent) : InteractableBehaviour(parent) {}
 
-        bool handleInput(SDL_KeyboardEvent &e) override;
+        bool handleInput(KeyEvent &e) override;
         void render(Font &font) override;
 
       private:
@@ -15,10 +21,45 @@ struct FireEntity : Entity {
         int choosingItemIndex{0};
     };
 
+    /// Flickers between red and orange, and turns grey as the fire goes out
+    struct FlickerAnimation : Animation {
+        explicit FlickerAnimation(FireEntity &parent) : Animation(parent) {}
+
+        void update(double time) override;
+
+      private:
+        double mNextFlickerTime{0};
+    };
+
+    /// Light that shrinks as the fire dies down
+    struct FireLightProperty : LightEmittingProperty {
+        POOLED_ALLOCATION(FireLightProperty)
+
+        explicit FireLightProperty(FireEntity *parent) : LightEmittingProperty(parent, MAX_LIGHT_RADIUS) {}
+
+        int getRadius() const override;
+    };
+
     explicit FireEntity(std::string ID = "");
 
-    void render(Font &font, Point currentWorldPos) override;
-    void tick() override;
+    /// How much the fire level drops each tick
+    static constexpr float DECAY_PER_TICK = 0.005f;
+    /// Light radius of a freshly kindled fire
+    static const int MAX_LIGHT_RADIUS = 6;
+    /// How often the fire flickers, in seconds
+    static constexpr double FLICKER_SECONDS = 1.0 / 30;
+
+    /// A fire cannot be walked through but does not block light
+    void markOccupancy(OccupancyGrid &grid) const override;
+
+    /// Get how strongly the fire is burning, starting at 1 when it is kindled. Computed from the time since the fire was
+    /// last kindled so that the fire never has to be ticked
+    float getFireLevel() const;
+    /// Set the fire level back to 1
+    void rekindle();
 
-    float fireLevel{1};
+  private:
+    /// Tick at which the fire was last kindled
+    unsigned long mKindledTick;
+    FlickerAnimation mAnimation;
 };
\ No newline at end of file
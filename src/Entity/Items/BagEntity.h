@@ -3,5 +3,7 @@
 #include "../Entity.h"
 
 struct BagEntity : Entity {
+    POOLED_ALLOCATION(BagEntity)
+
     explicit BagEntity(std::string ID = "");
 };
\ No newline at end of file
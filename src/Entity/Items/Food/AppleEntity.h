@@ -3,6 +3,8 @@
 #include "EatableEntity.h"
 
 struct AppleEntity : EatableEntity {
+    POOLED_ALLOCATION(AppleEntity)
+
     const std::string SHORT_DESC = "A small, fist-sized fruit that is hopefully crispy and juicy";
     const std::string LONG_DESC = "This is a longer description of the apple";
 
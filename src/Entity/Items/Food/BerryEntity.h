@@ -3,6 +3,8 @@
 #include "EatableEntity.h"
 
 struct BerryEntity : EatableEntity {
+    POOLED_ALLOCATION(BerryEntity)
+
     const std::string SHORT_DESC = "A purple berry";
     const std::string LONG_DESC = "";
 
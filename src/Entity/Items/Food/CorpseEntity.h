@@ -3,5 +3,7 @@
 #include "EatableEntity.h"
 
 struct CorpseEntity : EatableEntity {
+    POOLED_ALLOCATION(CorpseEntity)
+
     CorpseEntity(std::string ID, float hungerRestoration, const std::string &corpseOf, int weight);
 };
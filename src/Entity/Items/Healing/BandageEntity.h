@@ -3,6 +3,8 @@
 #include "../../Entity.h"
 
 struct BandageEntity : Entity {
+    POOLED_ALLOCATION(BandageEntity)
+
     const std::string SHORT_DESC = "A rudimentary bandage made of grass";
 
     explicit BandageEntity(std::string ID = "");
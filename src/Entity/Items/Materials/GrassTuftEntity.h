@@ -3,6 +3,8 @@
 #include "../../Entity.h"
 
 struct GrassTuftEntity : Entity {
+    POOLED_ALLOCATION(GrassTuftEntity)
+
     const std::string SHORT_DESC = "A tuft of dry grass";
     const std::string LONG_DESC = "A tuft of dry grass, very useful";
 
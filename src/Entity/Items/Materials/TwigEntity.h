@@ -3,6 +3,8 @@
 #include "../../Entity.h"
 
 struct TwigEntity : Entity {
+    POOLED_ALLOCATION(TwigEntity)
+
     const std::string SHORT_DESC = "A thin, brittle twig";
     const std::string LONG_DESC = "It looks very useful! Who knows where it came from...";
 
@@ -3,5 +3,7 @@
 #include "../Entity.h"
 
 struct TorchEntity : Entity {
+    POOLED_ALLOCATION(TorchEntity)
+
     explicit TorchEntity(std::string ID = "");
 };
\ No newline at end of file
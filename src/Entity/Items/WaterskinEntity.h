@@ -3,5 +3,7 @@
 #include "../Entity.h"
 
 struct WaterskinEntity : Entity {
+    POOLED_ALLOCATION(WaterskinEntity)
+
     explicit WaterskinEntity();
 };
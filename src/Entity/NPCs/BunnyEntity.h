@@ -1,11 +1,18 @@
 #pragma once
 
+#include "../../Animation/Animation.h"
 #include "../Entity.h"
 
 struct BunnyEntity : Entity {
+    POOLED_ALLOCATION(BunnyEntity)
+
     explicit BunnyEntity();
 
     void render(Font &font, Point currentWorldPos) override;
 
     bool isInHome() const;
+
+  private:
+    /// Hops between its two sprites
+    FrameAnimation mAnimation;
 };
\ No newline at end of file
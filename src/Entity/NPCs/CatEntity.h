@@ -3,6 +3,8 @@
 #include "../Entity.h"
 
 struct CatEntity : Entity {
+    POOLED_ALLOCATION(CatEntity)
+
     explicit CatEntity(std::string ID = "");
 
     void destroy() override;
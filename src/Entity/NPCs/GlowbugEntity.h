@@ -1,9 +1,14 @@
 #pragma once
 
+#include "../../Animation/Animation.h"
 #include "../Entity.h"
 
 struct GlowbugEntity : Entity {
+    POOLED_ALLOCATION(GlowbugEntity)
+
     explicit GlowbugEntity(std::string ID = "");
 
-    void render(Font &font, Point currentWorldPos) override;
+  private:
+    /// Flickers between glowing, dim and dark
+    FrameAnimation mAnimation;
 };
@@ -3,6 +3,8 @@
 #include "../Entity.h"
 
 struct WolfEntity : Entity {
+    POOLED_ALLOCATION(WolfEntity)
+
     explicit WolfEntity(std::string ID = "");
 
     void destroy() override;
@@ -1,16 +1,18 @@
 #include "PlayerEntity.h"
 
+#include "../AllocationCounter.h"
 #include "../Behaviour/InteractableBehaviour.h"
+#include "../EventBus.h"
+#include "../Events.h"
 #include "../UI/MessageBoxRenderer.h"
 #include "../UI/NotificationMessageRenderer.h"
 #include "../UI/Screens/Screen.h"
 #include "../UI/Screens/Screens.h"
-#include "../flags.h"
 #include "EntityManager.h"
-#include "UI/StatusUIEntity.h"
 
 bool PlayerEntity::attack(const Point &attackPos) {
-    auto entitiesInSquare = EntityManager::getInstance().getEntitiesAtPosFaster(attackPos);
+    ALLOCATION_ZONE("PlayerEntity::attack");
+    auto entitiesInSquare = EntityManager::getInstance().getEntitiesAtPosFaster(attackPos, Arena::getFrameArena());
 
     if (entitiesInSquare.empty()) {
         return false;
@@ -20,6 +22,8 @@ bool PlayerEntity::attack(const Point &attackPos) {
     // roll and damage the enemy
     int damage = rollDamage();
     enemy->mHp -= damage;
+    // the enemy needs ticking to regenerate and react
+    enemy->wake();
 
     // send hit notification message
     NotificationMessageRenderer::getInstance().queueMessage(
@@ -38,13 +42,13 @@ bool PlayerEntity::attack(const Point &attackPos) {
     if (enemy->getBehaviourByID("ChaseAndAttackBehaviour") != nullptr)
         enemy->getBehaviourByID("ChaseAndAttackBehaviour")->enable();
 
-    // set the player's attack target to the enemy
-    auto &ui = dynamic_cast<StatusUIEntity &>(*EntityManager::getInstance().getEntityByID("StatusUI"));
-    ui.setAttackTarget(enemy->mID);
+    // let the status UI show the enemy as the player's attack target
+    auto &eventBus = EventBus::getInstance();
+    eventBus.publish(enemy->getWorldPos(), AttackEvent{mID, enemy->mID, damage});
 
     // if the enemy died, delete the enemy and stop attacking
     if (enemy->mHp <= 0) {
-        ui.clearAttackTarget();
+        eventBus.publish(enemy->getWorldPos(), DeathEvent{enemy->mID, enemy->mName, enemy->getPos()});
         EntityManager::getInstance().queueForDeletion(enemy->mID);
         attacking = false;
         NotificationMessageRenderer::getInstance().queueMessage(enemy->mGraphic + " " + enemy->mName +
@@ -65,15 +69,15 @@ void PlayerEntity::tick() {
     Entity::tick();
 }
 
-void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
+void PlayerEntity::handleInput(KeyEvent &e, bool &quit,
                                std::unordered_map<ScreenType, std::unique_ptr<Screen>> &screens) {
-    auto key = e.key;
-    auto mod = e.mod;
+    auto key = e.mKey;
+    auto mod = e.mMod;
 
     bool didAction = false;
 
     if (showingTooMuchWeightMessage) {
-        if (key == SDLK_ESCAPE || key == SDLK_RETURN)
+        if (key == KEY_ESCAPE || key == KEY_RETURN)
             showingTooMuchWeightMessage = false;
         return;
     }
@@ -91,8 +95,9 @@ void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
 
     if (mHp > 0) {
         // Handle interaction
-        if (key == SDLK_SPACE) {
-            auto entitiesSurrounding = EntityManager::getInstance().getEntitiesSurroundingFaster(mPos);
+        if (key == KEY_SPACE) {
+            auto entitiesSurrounding =
+                EntityManager::getInstance().getEntitiesSurroundingFaster(mPos, Arena::getFrameArena());
 
             // Just use the first interactable entity found
             for (auto &entity : entitiesSurrounding) {
@@ -112,8 +117,8 @@ void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
         }
 
         // Handle looting
-        if (key == SDLK_G) {
-            auto entitiesAtPos = EntityManager::getInstance().getEntitiesAtPosFaster(mPos);
+        if (key == KEY_G) {
+            auto entitiesAtPos = EntityManager::getInstance().getEntitiesAtPosFaster(mPos, Arena::getFrameArena());
 
             // TODO: need to handle multiple items on same square properly
             //            std::vector<std::shared_ptr<Entity>> waterEntities;
@@ -171,33 +176,33 @@ void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
 
     postLooting:
 
-        if (mHp > 0 && (key == SDLK_H || key == SDLK_J || key == SDLK_K || key == SDLK_L || key == SDLK_Y ||
-                        key == SDLK_U || key == SDLK_B || key == SDLK_N)) // Only ever attack if moving
+        if (mHp > 0 && (key == KEY_H || key == KEY_J || key == KEY_K || key == KEY_L || key == KEY_Y ||
+                        key == KEY_U || key == KEY_B || key == KEY_N)) // Only ever attack if moving
         {
             Point posOffset;
             switch (key) {
-            case SDLK_H:
+            case KEY_H:
                 posOffset = Point(-1, 0);
                 break;
-            case SDLK_J:
+            case KEY_J:
                 posOffset = Point(0, 1);
                 break;
-            case SDLK_K:
+            case KEY_K:
                 posOffset = Point(0, -1);
                 break;
-            case SDLK_L:
+            case KEY_L:
                 posOffset = Point(1, 0);
                 break;
-            case SDLK_Y:
+            case KEY_Y:
                 posOffset = Point(-1, -1);
                 break;
-            case SDLK_U:
+            case KEY_U:
                 posOffset = Point(1, -1);
                 break;
-            case SDLK_B:
+            case KEY_B:
                 posOffset = Point(-1, 1);
                 break;
-            case SDLK_N:
+            case KEY_N:
                 posOffset = Point(1, 1);
                 break;
             default:
@@ -207,7 +212,7 @@ void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
 
             Point newPos = getPos() + posOffset;
 
-            std::vector<Entity *> entitiesInSpace = EntityManager::getInstance().getEntitiesAtPosFaster(newPos);
+            auto entitiesInSpace = EntityManager::getInstance().getEntitiesAtPosFaster(newPos, Arena::getFrameArena());
 
             if (!entitiesInSpace.empty()) {
                 // TODO: what if more than one enemy in space?
@@ -216,7 +221,7 @@ void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
                 // Check whether or not to attack
                 if (entity->canBeAttacked() && ((entity->getBehaviourByID("HostilityBehaviour") != nullptr &&
                                                  entity->getBehaviourByID("HostilityBehaviour")->isEnabled()) ||
-                                                (mod & SDL_KMOD_SHIFT) // force attack // NOLINT(hicpp-signed-bitwise)
+                                                (mod & KEYMOD_SHIFT) // force attack // NOLINT(hicpp-signed-bitwise)
                                                 || attacking           // already attacking
                                                 )) {
                     attack(newPos);
@@ -231,40 +236,40 @@ void PlayerEntity::handleInput(SDL_KeyboardEvent &e, bool &quit,
             didAction = true;
         }
 
-        if (key == SDLK_I) {
+        if (key == KEY_I) {
             screens[ScreenType::INVENTORY]->enable();
         }
 
-        if (key == SDLK_PERIOD) {
-            EntityManager::getInstance().broadcast(SIGNAL_FORCE_WAIT);
+        if (key == KEY_PERIOD) {
+            EventBus::getInstance().publish(ForceWaitEvent{});
             didAction = true;
         }
 
-        if (key == SDLK_SEMICOLON) {
+        if (key == KEY_SEMICOLON) {
             auto &b = dynamic_cast<InspectionDialog &>(*screens[ScreenType::INSPECTION]);
             b.enableAtPoint(mPos);
         }
 
-        if (key == SDLK_C)
+        if (key == KEY_C)
             screens[ScreenType::CRAFTING]->enable();
 
-        if (key == SDLK_E)
+        if (key == KEY_E)
             screens[ScreenType::EQUIPMENT]->enable();
 
-        if (key == SDLK_M)
+        if (key == KEY_M)
             screens[ScreenType::NOTIFICATION]->enable();
 
-        if (mod & SDL_KMOD_SHIFT && key == SDLK_SLASH)
+        if (mod & KEYMOD_SHIFT && key == KEY_SLASH)
             screens[ScreenType::HELP]->enable();
 
-        if (mod & SDL_KMOD_SHIFT && key == SDLK_D)
+        if (mod & KEYMOD_SHIFT && key == KEY_D)
             screens[ScreenType::DEBUG]->enable();
     }
 
     if (didAction)
         EntityManager::getInstance().tick();
 
-    if (mHp <= 0 && key == SDLK_RETURN)
+    if (mHp <= 0 && key == KEY_RETURN)
         quit = true;
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 #include "Entity.h"
-#include <SDL3/SDL_events.h>
+#include "../KeyEvent.h"
 
 struct Screen;
 enum class ScreenType;
@@ -27,8 +27,10 @@ struct PlayerEntity : Entity {
     bool attack(const Point &attackPos);
     /// Tick entity, taking hunger into account
     void tick() override;
+    /// Hunger changes every tick
+    bool canSleep() const override { return false; }
     /// Handle most of the ingame interaction
-    void handleInput(SDL_KeyboardEvent &e, bool &quit,
+    void handleInput(KeyEvent &e, bool &quit,
                      std::unordered_map<ScreenType, std::unique_ptr<Screen>> &screens);
     /// Same as usual render except can show a "too much weight" message box, and offload additional rendering to
     /// "mEntityInteractingWith"
@@ -2,6 +2,8 @@
 #include "../Entity.h"
 
 struct BushEntity : Entity {
+    POOLED_ALLOCATION(BushEntity)
+
     const int RESTOCK_RATE = 200; // ticks
 
     const std::string SHORT_DESC = "It's a bush!";
@@ -3,6 +3,8 @@
 #include "../Entity.h"
 
 struct GrassEntity : Entity {
+    POOLED_ALLOCATION(GrassEntity)
+
     const int RESTOCK_RATE = 100; // ticks
 
     const std::string SHORT_DESC = "It is dry grass";
@@ -1,14 +1,36 @@
 #include "StatusUIEntity.h"
 
 #include "../../Color.h"
+#include "../../Events.h"
 #include "../../Font.h"
 #include "../../World.h"
-#include "../../flags.h"
 #include "../EntityManager.h"
 
 StatusUIEntity::StatusUIEntity()
     : StatusUIEntity(dynamic_cast<PlayerEntity &>(*EntityManager::getInstance().getEntityByID("Player"))) {}
 
+StatusUIEntity::StatusUIEntity(PlayerEntity &player) : Entity("StatusUI", "", ""), player(player) {
+    mRenderingLayer = 1; // Keep on background
+    mCanBeAttacked = false;
+
+    auto &eventBus = EventBus::getInstance();
+    mForceWaitSubscription = eventBus.subscribe<ForceWaitEvent>([this](const ForceWaitEvent &) {
+        if (forceTickDisplayTimer > 0) {
+            ticksWaitedDuringAnimation++;
+        }
+        forceTickDisplayTimer = FORCE_TICK_DISPLAY_LENGTH;
+    });
+    // Show whatever the player last hit, until it dies
+    mAttackSubscription = eventBus.subscribe<AttackEvent>([this](const AttackEvent &event) {
+        if (event.mAttackerID == this->player.mID)
+            setAttackTarget(event.mTargetID);
+    });
+    mDeathSubscription = eventBus.subscribe<DeathEvent>([this](const DeathEvent &event) {
+        if (event.mID == mAttackTargetID)
+            clearAttackTarget();
+    });
+}
+
 void StatusUIEntity::render(Font &font, Point /*currentWorldPos*/) {
     std::string colorStr;
     float hpPercent = player.mHp / player.mMaxHp;
@@ -45,7 +67,7 @@ void StatusUIEntity::render(Font &font, Point /*currentWorldPos*/) {
                 (ticksWaitedDuringAnimation > 1 ? "s" : "") + "...",
             World::SCREEN_WIDTH - X_OFFSET - 8, World::SCREEN_HEIGHT - 2,
             Color(0xFF, 0xFF, 0xFF,
-                  static_cast<Uint8>(static_cast<float>(forceTickDisplayTimer) / FORCE_TICK_DISPLAY_LENGTH * 0xFF)),
+                  static_cast<uint8_t>(static_cast<float>(forceTickDisplayTimer) / FORCE_TICK_DISPLAY_LENGTH * 0xFF)),
             Color::getColor("transparent"));
     } else {
         forceTickDisplayTimer = 0;
@@ -76,17 +98,6 @@ void StatusUIEntity::render(Font &font, Point /*currentWorldPos*/) {
     font.drawText(EntityManager::getInstance().getTimeOfDay().toWordString(), World::SCREEN_WIDTH - X_OFFSET, 8);
 }
 
-void StatusUIEntity::emit(uint32_t signal) {
-    if (signal & SIGNAL_FORCE_WAIT) {
-        if (forceTickDisplayTimer > 0) {
-            ticksWaitedDuringAnimation++;
-        }
-        forceTickDisplayTimer = FORCE_TICK_DISPLAY_LENGTH;
-    }
-
-    Entity::emit(signal);
-}
-
 void StatusUIEntity::tick() {
     if (!mAttackTargetID.empty()) {
         auto attackTarget = EntityManager::getInstance().getEntityByID(mAttackTargetID);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../EventBus.h"
 #include "../PlayerEntity.h"
 
 class StatusUIEntity : public Entity {
@@ -14,17 +15,20 @@ class StatusUIEntity : public Entity {
     std::string mAttackTargetID;
     const int X_OFFSET = 10;
 
+    EventSubscription mForceWaitSubscription;
+    EventSubscription mAttackSubscription;
+    EventSubscription mDeathSubscription;
+
   public:
     StatusUIEntity();
 
-    explicit StatusUIEntity(PlayerEntity &player) : Entity("StatusUI", "", ""), player(player) {
-        mRenderingLayer = 1; // Keep on background
-        mCanBeAttacked = false;
-    }
+    /// Show the status of player, subscribing to the events that change what is shown
+    explicit StatusUIEntity(PlayerEntity &player);
 
     void render(Font &font, Point currentWorldPos) override;
-    void emit(Uint32 signal) override;
     void tick() override;
+    /// The attack target timer counts down every tick
+    bool canSleep() const override { return false; }
     void setAttackTarget(const std::string &attackTargetID) {
         mAttackTargetID = attackTargetID;
         attackTargetTimer = 10;
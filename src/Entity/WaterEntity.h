@@ -1,13 +1,15 @@
 #pragma once
 
-#include "../utils.h"
+#include "../Random.h"
 #include "Entity.h"
 
 struct WaterEntity : Entity {
+    POOLED_ALLOCATION(WaterEntity)
+
     explicit WaterEntity(std::string ID = "") : Entity(std::move(ID), "Water", "") {
         mRenderingLayer = 10;
 
-        if (randDouble() > 0.5)
+        if (RandomStreams::getInstance().makeStream(RandomStream::COSMETIC, mID).nextDouble() > 0.5)
             mGraphic = "${black}$[cyan]$(approx)";
         else
             mGraphic = "${black}$[cyan]~";
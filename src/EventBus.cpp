@@ -0,0 +1,21 @@
+#include "EventBus.h"
+
+size_t EventBus::sNumEventTypes = 0;
+
+void EventBus::dispatch() {
+    // A handler that dispatches would deliver events out of order
+    if (mDispatching)
+        return;
+    mDispatching = true;
+
+    // Handlers may publish more events, which join the end of the queue and are delivered in this dispatch too
+    for (size_t i = 0; i < mQueue.size(); ++i)
+        mQueue[i].first->deliver(mQueue[i].second);
+
+    for (auto &channel : mChannels) {
+        if (channel != nullptr)
+            channel->clearQueue();
+    }
+    mQueue.clear();
+    mDispatching = false;
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Point.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class EventSubscription;
+
+/// Delivers typed events, such as those in Events.h, to the handlers subscribed to their type. Publishing only queues
+/// an event, and the queue is delivered in the order it was published when dispatch() is called at set points in the
+/// tick (see EntityManager::tick()), so handlers never run in the middle of the code that published. Events with no
+/// subscribers are dropped when published, so they cost nothing. Only used from the simulation thread, and never while
+/// entities plan in parallel, so behaviours publish from their intents
+class EventBus {
+  public:
+    /// Get the singleton instance. It is never destroyed, so subscriptions held by other singletons can end at exit
+    static EventBus &getInstance() {
+        static auto *instance = new EventBus;
+        return *instance;
+    }
+
+    EventBus(const EventBus &) = delete;
+    void operator=(const EventBus &) = delete;
+
+    /// Call handler with every event of type E until the returned subscription is destroyed
+    template <typename E> EventSubscription subscribe(std::function<void(const E &)> handler);
+    /// Call handler with every event of type E published at worldPos, or with no position, until the returned
+    /// subscription is destroyed
+    template <typename E> EventSubscription subscribe(Point worldPos, std::function<void(const E &)> handler);
+
+    /// Queue an event to be delivered to every subscriber of its type
+    template <typename E> void publish(E event) { enqueue(false, Point(), std::move(event)); }
+    /// Queue an event that happened on the screen at worldPos
+    template <typename E> void publish(Point worldPos, E event) { enqueue(true, worldPos, std::move(event)); }
+
+    /// Deliver the queued events, including those published by the handlers while delivering
+    void dispatch();
+
+    /// Are any handlers subscribed to events of type E? Useful to skip building an event that is expensive to make
+    template <typename E> bool hasSubscribers() { return !getChannel<E>().mSubscribers.empty(); }
+
+  private:
+    friend class EventSubscription;
+
+    /// The subscribers and queued events of one type
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        /// Deliver the queued event at index to its subscribers
+        virtual void deliver(size_t index) = 0;
+        virtual void clearQueue() = 0;
+        virtual void unsubscribe(uint64_t ID) = 0;
+    };
+
+    template <typename E> struct Channel : ChannelBase {
+        struct Subscriber {
+            uint64_t mID;
+            bool mHasWorldPos;
+            Point mWorldPos;
+            /// Empty once unsubscribed while delivering
+            std::function<void(const E &)> mHandler;
+        };
+
+        struct QueuedEvent {
+            E mEvent;
+            bool mHasWorldPos;
+            Point mWorldPos;
+        };
+
+        void deliver(size_t index) override {
+            // Handlers may publish, subscribe and unsubscribe, so don't hold on to references into the vectors. Each
+            // event is only delivered once, so it can be moved out of the queue
+            const E event = std::move(mQueue[index].mEvent);
+            const bool hasWorldPos = mQueue[index].mHasWorldPos;
+            const Point worldPos = mQueue[index].mWorldPos;
+
+            mDelivering = true;
+            const size_t numSubscribers = mSubscribers.size();
+            for (size_t i = 0; i < numSubscribers; ++i) {
+                const auto &subscriber = mSubscribers[i];
+                if (!subscriber.mHandler)
+                    continue;
+                if (hasWorldPos && subscriber.mHasWorldPos && worldPos != subscriber.mWorldPos)
+                    continue;
+                auto handler = subscriber.mHandler;
+                handler(event);
+            }
+            mDelivering = false;
+
+            mSubscribers.erase(std::remove_if(mSubscribers.begin(), mSubscribers.end(),
+                                              [](const Subscriber &subscriber) { return !subscriber.mHandler; }),
+                               mSubscribers.end());
+        }
+
+        void clearQueue() override { mQueue.clear(); }
+
+        void unsubscribe(uint64_t ID) override {
+            auto subscriber = std::find_if(mSubscribers.begin(), mSubscribers.end(),
+                                           [ID](const Subscriber &subscriber) { return subscriber.mID == ID; });
+            if (subscriber == mSubscribers.end())
+                return;
+            // Removed once delivery finishes, so the subscriber indices stay valid
+            if (mDelivering)
+                subscriber->mHandler = nullptr;
+            else
+                mSubscribers.erase(subscriber);
+        }
+
+        std::vector<Subscriber> mSubscribers;
+        std::vector<QueuedEvent> mQueue;
+        bool mDelivering{false};
+    };
+
+    EventBus() = default;
+
+    /// Index of the type E among the event types used so far
+    template <typename E> static size_t getTypeIndex() {
+        static const size_t index = sNumEventTypes++;
+        return index;
+    }
+
+    template <typename E> Channel<E> &getChannel() {
+        const auto index = getTypeIndex<E>();
+        if (index >= mChannels.size())
+            mChannels.resize(index + 1);
+        if (mChannels[index] == nullptr)
+            mChannels[index] = std::make_unique<Channel<E>>();
+        return static_cast<Channel<E> &>(*mChannels[index]);
+    }
+
+    template <typename E> void enqueue(bool hasWorldPos, Point worldPos, E event) {
+        auto &channel = getChannel<E>();
+        // Nobody is listening, so there is nothing to deliver
+        if (channel.mSubscribers.empty())
+            return;
+        channel.mQueue.push_back({std::move(event), hasWorldPos, worldPos});
+        mQueue.emplace_back(&channel, channel.mQueue.size() - 1);
+    }
+
+    template <typename E>
+    EventSubscription addSubscriber(bool hasWorldPos, Point worldPos, std::function<void(const E &)> handler);
+
+    static size_t sNumEventTypes;
+
+    /// Channels indexed by the type index of their events
+    std::vector<std::unique_ptr<ChannelBase>> mChannels;
+    /// Queued events of every type in the order they were published, as their channel and index in its queue
+    std::vector<std::pair<ChannelBase *, size_t>> mQueue;
+    uint64_t mNextSubscriptionID{1};
+    bool mDispatching{false};
+};
+
+/// Keeps a handler subscribed to an EventBus for as long as it lives. Move-only, and empty when default constructed
+class EventSubscription {
+  public:
+    EventSubscription() = default;
+    ~EventSubscription() { unsubscribe(); }
+
+    EventSubscription(const EventSubscription &) = delete;
+    EventSubscription &operator=(const EventSubscription &) = delete;
+
+    EventSubscription(EventSubscription &&other) noexcept : mChannel(other.mChannel), mID(other.mID) {
+        other.mChannel = nullptr;
+    }
+    EventSubscription &operator=(EventSubscription &&other) noexcept {
+        if (this != &other) {
+            unsubscribe();
+            mChannel = other.mChannel;
+            mID = other.mID;
+            other.mChannel = nullptr;
+        }
+        return *this;
+    }
+
+    /// Stop calling the handler, including for events already queued
+    void unsubscribe() {
+        if (mChannel == nullptr)
+            return;
+        mChannel->unsubscribe(mID);
+        mChannel = nullptr;
+    }
+
+  private:
+    friend class EventBus;
+
+    EventSubscription(EventBus::ChannelBase *channel, uint64_t ID) : mChannel(channel), mID(ID) {}
+
+    EventBus::ChannelBase *mChannel{nullptr};
+    uint64_t mID{0};
+};
+
+template <typename E> EventSubscription EventBus::subscribe(std::function<void(const E &)> handler) {
+    return addSubscriber<E>(false, Point(), std::move(handler));
+}
+
+template <typename E> EventSubscription EventBus::subscribe(Point worldPos, std::function<void(const E &)> handler) {
+    return addSubscriber<E>(true, worldPos, std::move(handler));
+}
+
+template <typename E>
+EventSubscription EventBus::addSubscriber(bool hasWorldPos, Point worldPos, std::function<void(const E &)> handler) {
+    auto &channel = getChannel<E>();
+    const auto ID = mNextSubscriptionID++;
+    channel.mSubscribers.push_back({ID, hasWorldPos, worldPos, std::move(handler)});
+    return EventSubscription(&channel, ID);
+}
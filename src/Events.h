@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Point.h"
+
+#include <string>
+
+// Events published on the EventBus. Each is published at the world position (screen) where it happened, if it has
+// one, so that subscribers can listen to just the screens they care about
+
+/// The player waited a tick instead of acting
+struct ForceWaitEvent {};
+
+/// An entity damaged another, published at the target's world position
+struct AttackEvent {
+    std::string mAttackerID;
+    std::string mTargetID;
+    int mDamage;
+};
+
+/// An entity was killed and has been queued for deletion, which happens before the next tick's entities are ticked.
+/// Published at the entity's world position
+struct DeathEvent {
+    std::string mID;
+    std::string mName;
+    Point mPos;
+};
+
+/// The player crafted something from a recipe
+struct CraftEvent {
+    std::string mNameOfProduct;
+};
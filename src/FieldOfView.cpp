@@ -0,0 +1,97 @@
+#include "FieldOfView.h"
+#include "Font.h"
+#include "OccupancyGrid.h"
+#include "World.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Far enough to reach every cell of the screen from anywhere on it
+const int SIGHT_RADIUS = static_cast<int>(
+    std::ceil(std::sqrt(World::SCREEN_WIDTH * World::SCREEN_WIDTH + World::SCREEN_HEIGHT * World::SCREEN_HEIGHT)));
+const int NUM_SCREEN_CELLS = World::SCREEN_WIDTH * World::SCREEN_HEIGHT;
+} // namespace
+
+void FieldOfView::update(const OccupancyGrid &grid, Point playerPos, bool isDark,
+                         const std::vector<LightMapPoint> &lights) {
+    bool sightChanged = !mHasSight || playerPos != mSight.mOrigin || grid.getRevision() != mRevision;
+    if (sightChanged) {
+        computeVisibility(grid, playerPos, SIGHT_RADIUS, mSight);
+        mRevision = grid.getRevision();
+        mHasSight = true;
+        mScreenOrigin = World::worldPosToWorld(
+            Point(playerPos.mX / World::SCREEN_WIDTH, playerPos.mY / World::SCREEN_HEIGHT));
+    }
+
+    // Lights move every tick, so in the dark the lit cells must be redone every update. This is cheap compared to the
+    // shadowcasting as it only touches the cells around each light
+    if (sightChanged || isDark || isDark != mWasDark)
+        updateVisibleCells(isDark, lights);
+    mWasDark = isDark;
+}
+
+void FieldOfView::updateVisibleCells(bool isDark, const std::vector<LightMapPoint> &lights) {
+    mVisible.assign(NUM_SCREEN_CELLS, 0);
+
+    if (isDark) {
+        mLit.assign(NUM_SCREEN_CELLS, 0);
+        const float aspect = static_cast<float>(CHAR_WIDTH) / CHAR_HEIGHT;
+        for (const auto &light : lights) {
+            const int xExtent = static_cast<int>(std::ceil(light.mRadius / aspect));
+            const int x0 = std::max(0, light.mPoint.mX - xExtent);
+            const int x1 = std::min(World::SCREEN_WIDTH, light.mPoint.mX + xExtent + 1);
+            const int y0 = std::max(0, light.mPoint.mY - light.mRadius);
+            const int y1 = std::min(World::SCREEN_HEIGHT, light.mPoint.mY + light.mRadius + 1);
+
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    const int dx = x - light.mPoint.mX;
+                    const int dy = y - light.mPoint.mY;
+                    // Same footprint as the light map kernel
+                    const float distX = static_cast<float>(dx) * aspect;
+                    if (distX * distX + static_cast<float>(dy * dy) >= static_cast<float>(light.mRadius * light.mRadius))
+                        continue;
+                    if (light.mVisibility == nullptr || light.mVisibility->isVisible(dx, dy))
+                        mLit[y * World::SCREEN_WIDTH + x] = 1;
+                }
+            }
+        }
+    }
+
+    auto &seen = mSeen[Point(mScreenOrigin.mX / World::SCREEN_WIDTH, mScreenOrigin.mY / World::SCREEN_HEIGHT)];
+    if (seen.empty())
+        seen.assign(NUM_SCREEN_CELLS, 0);
+
+    for (int y = 0; y < World::SCREEN_HEIGHT; ++y) {
+        for (int x = 0; x < World::SCREEN_WIDTH; ++x) {
+            const int dx = mScreenOrigin.mX + x - mSight.mOrigin.mX;
+            const int dy = mScreenOrigin.mY + y - mSight.mOrigin.mY;
+            if (!mSight.isVisible(dx, dy))
+                continue;
+
+            const int i = y * World::SCREEN_WIDTH + x;
+            if (isDark && !mLit[i] && std::max(std::abs(dx), std::abs(dy)) > DARK_SIGHT_RADIUS)
+                continue;
+
+            mVisible[i] = 1;
+            seen[i] = 1;
+        }
+    }
+}
+
+bool FieldOfView::isVisible(const Point &pos) const {
+    const Point screenPos = pos - mScreenOrigin;
+    if (mVisible.empty() || screenPos.mX < 0 || screenPos.mX >= World::SCREEN_WIDTH || screenPos.mY < 0 ||
+        screenPos.mY >= World::SCREEN_HEIGHT)
+        return false;
+    return mVisible[screenPos.mY * World::SCREEN_WIDTH + screenPos.mX] != 0;
+}
+
+bool FieldOfView::hasSeen(const Point &pos) const {
+    auto it = mSeen.find(Point(pos.mX / World::SCREEN_WIDTH, pos.mY / World::SCREEN_HEIGHT));
+    if (it == mSeen.end())
+        return false;
+    const Point screenPos = World::worldToScreen(pos);
+    return it->second[screenPos.mY * World::SCREEN_WIDTH + screenPos.mX] != 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "LightMapPoint.h"
+#include "Lighting/Shadowcasting.h"
+#include "Point.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class OccupancyGrid;
+/// The cells of the player's screen that the player can currently see, plus every cell they have ever seen.
+/// Sight is blocked by opaque cells, and in the dark is further limited to lit cells and those right next to the player.
+/// The shadowcasting is only redone when the player moves or the occupancy grid changes
+class FieldOfView {
+  public:
+    /// How far the player can see in the dark without any light
+    static const int DARK_SIGHT_RADIUS = 2;
+
+    /// Bring the field of view up to date
+    /// \param grid occupancy around the player
+    /// \param playerPos player position in world space
+    /// \param isDark whether sight should be limited to lit cells
+    /// \param lights light sources on the player's screen in screen cell coords
+    void update(const OccupancyGrid &grid, Point playerPos, bool isDark, const std::vector<LightMapPoint> &lights);
+
+    /// Can the player currently see the cell at world position pos? Only cells on the player's screen can be visible
+    bool isVisible(const Point &pos) const;
+    /// Has the player ever seen the cell at world position pos?
+    bool hasSeen(const Point &pos) const;
+
+  private:
+    /// Recompute mVisible from mSight, limiting it to lit cells if isDark
+    void updateVisibleCells(bool isDark, const std::vector<LightMapPoint> &lights);
+
+    /// Cells in line of sight of the player
+    VisibilityMask mSight;
+    /// Occupancy revision mSight was computed against
+    uint32_t mRevision{0};
+    bool mHasSight{false};
+    bool mWasDark{false};
+
+    /// World space position of the top-left corner of the player's screen
+    Point mScreenOrigin;
+    /// Visible cells of the player's screen, row-major
+    std::vector<uint8_t> mVisible;
+    /// Scratch buffer of the lit cells of the player's screen
+    std::vector<uint8_t> mLit;
+    /// Cells seen so far of each screen that has been visited, keyed by world position
+    std::unordered_map<Point, std::vector<uint8_t>> mSeen;
+};
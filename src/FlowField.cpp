@@ -0,0 +1,62 @@
+#include "FlowField.h"
+#include "OccupancyGrid.h"
+
+namespace {
+/// Orthogonal steps first so that ties prefer them
+const Point STEPS[] = {Point(1, 0),  Point(-1, 0), Point(0, 1),   Point(0, -1),
+                       Point(1, 1), Point(-1, 1), Point(1, -1), Point(-1, -1)};
+} // namespace
+
+const int FlowField::UNREACHABLE;
+
+void FlowField::compute(const OccupancyGrid &grid, Point target) {
+    mTarget = target;
+    mOrigin = grid.getOrigin();
+    mWidth = grid.getWidth();
+    mHeight = grid.getHeight();
+    mDistances.assign(static_cast<size_t>(mWidth * mHeight), UNREACHABLE);
+    mFrontier.clear();
+
+    if (!contains(target))
+        return;
+
+    mDistances[index(target)] = 0;
+    mFrontier.push_back(target);
+
+    // The frontier is used as a queue, with head marking the front
+    for (size_t head = 0; head < mFrontier.size(); ++head) {
+        const Point current = mFrontier[head];
+        const int distance = mDistances[index(current)] + 1;
+
+        for (const auto &step : STEPS) {
+            const Point next = current + step;
+            if (!contains(next) || mDistances[index(next)] != UNREACHABLE || grid.isSolid(next))
+                continue;
+
+            mDistances[index(next)] = distance;
+            mFrontier.push_back(next);
+        }
+    }
+}
+
+int FlowField::getDistance(const Point &pos) const {
+    if (!contains(pos))
+        return UNREACHABLE;
+    return mDistances[index(pos)];
+}
+
+Point FlowField::getNextStep(const Point &from) const {
+    const int distance = getDistance(from);
+
+    if (distance != UNREACHABLE) {
+        for (const auto &step : STEPS) {
+            const Point next = from + step;
+            if (distance > 0 && getDistance(next) == distance - 1)
+                return next;
+        }
+        return from;
+    }
+
+    // Can't reach the target, so just head straight for it
+    return from.stepTowards(mTarget);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Point.h"
+
+#include <vector>
+
+class OccupancyGrid;
+/// Distance in steps from every cell of an occupancy grid to a single target, found by a breadth-first search that
+/// moves in all eight directions and does not pass through solid cells.
+/// Computed once and then shared by every entity heading for the target, each of which can look up its next step in
+/// constant time
+class FlowField {
+  public:
+    /// Distance of cells that cannot reach the target
+    static const int UNREACHABLE = -1;
+
+    /// Recompute the distances to target over the whole of grid
+    /// \param grid occupancy to search, solid cells are not walked through
+    /// \param target world position to find paths to
+    void compute(const OccupancyGrid &grid, Point target);
+
+    /// Get the number of steps from pos to the target, or UNREACHABLE
+    int getDistance(const Point &pos) const;
+
+    /// Get the position to move to from `from` to get one step closer to the target. If the target cannot be reached
+    /// from `from` (or it is outside the grid) then step straight towards the target instead
+    /// \param from world position to step from
+    /// \return the next position, which is the target itself if `from` is next to it
+    Point getNextStep(const Point &from) const;
+
+    /// Get the position the field leads to
+    const Point &getTarget() const { return mTarget; }
+
+  private:
+    int index(const Point &pos) const { return (pos.mY - mOrigin.mY) * mWidth + (pos.mX - mOrigin.mX); }
+    bool contains(const Point &pos) const {
+        return pos.mX >= mOrigin.mX && pos.mX < mOrigin.mX + mWidth && pos.mY >= mOrigin.mY &&
+               pos.mY < mOrigin.mY + mHeight;
+    }
+
+    Point mTarget;
+    Point mOrigin;
+    int mWidth{0};
+    int mHeight{0};
+    std::vector<int> mDistances;
+    /// Breadth-first search frontier, kept to avoid reallocating every time the field is computed
+    std::vector<Point> mFrontier;
+};
@@ -1,7 +1,9 @@
 #include "Font.h"
+#include "AllocationCounter.h"
 #include "Color.h"
 #include "Point.h"
-#include "Texture.h"
+#include "Profiler.h"
+#include "RenderSnapshot.h"
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -9,9 +11,7 @@
 #include <stdexcept>
 #include <vector>
 
-Font::Font(Texture &texture, int cellWidth, int cellHeight, int numPerRow, const std::string &characters,
-           SDL_Renderer *renderer)
-    : mTexture(texture), mCellWidth(cellWidth), mCellHeight(cellHeight), mRenderer(renderer) {
+Font::Font(int numPerRow, const std::string &characters) {
     // Separate characters string by whitespace
     std::vector<std::string> words;
     std::istringstream iss(characters);
@@ -26,11 +26,6 @@ Font::Font(Texture &texture, int cellWidth, int cellHeight, int numPerRow, const
     }
 }
 
-void Font::setFontColor(Color c) {
-    SDL_SetTextureColorMod(mTexture.getTexture(), c.r, c.g, c.b);
-    SDL_SetTextureAlphaMod(mTexture.getTexture(), c.a);
-}
-
 int Font::draw(const std::string &character, int x, int y, Color fColor, Color bColor) {
     std::tuple<int, int> position;
 
@@ -42,34 +37,19 @@ int Font::draw(const std::string &character, int x, int y, Color fColor, Color b
         return -1;
     }
 
-    setFontColor(fColor);
-
-    int cellX = std::get<0>(position);
-    int cellY = std::get<1>(position);
-
-    SDL_FRect srcRect = {
-        static_cast<float>(cellX * mCellWidth),
-        static_cast<float>(cellY * mCellHeight),
-        static_cast<float>(mCellWidth),
-        static_cast<float>(mCellHeight),
-    };
-    SDL_FRect destRect = {
-        static_cast<float>(x * mCellWidth),
-        static_cast<float>(y * mCellHeight),
-        static_cast<float>(mCellWidth),
-        static_cast<float>(mCellHeight),
-    };
-
-    SDL_SetRenderDrawColor(mRenderer, bColor.r, bColor.g, bColor.b, bColor.a);
-    SDL_RenderFillRect(mRenderer, &destRect);
-
-    mTexture.render(&srcRect, &destRect);
+    GlyphCommand command{std::get<0>(position), std::get<1>(position), x, y, fColor, bColor};
+    if (mRecording != nullptr)
+        mRecording->push_back(command);
     return 0;
 }
 
+void Font::setRecording(std::vector<GlyphCommand> *commands) { mRecording = commands; }
+
 int Font::drawText(const std::string &text, int x0, int y) { return drawText(text, x0, y, -1); }
 
 int Font::drawText(const std::string &text, int x0, int y, Color fColor, Color bColor) {
+    PROFILE_ZONE("Font::drawText");
+    ALLOCATION_ZONE("Font::drawText");
     int x = x0;
 
     for (std::string::size_type i = 0; i < text.size(); ++i) {
@@ -108,7 +88,9 @@ int Font::drawText(const std::string &text, int x0, int y, Color fColor, Color b
 }
 
 int Font::drawText(const std::string &text, int x0, int y, int alpha) {
-    Color fColor = Color(0xFF, 0xFF, 0xFF, alpha == -1 ? 0xFF : static_cast<Uint8>(alpha));
+    PROFILE_ZONE("Font::drawText");
+    ALLOCATION_ZONE("Font::drawText");
+    Color fColor = Color(0xFF, 0xFF, 0xFF, alpha == -1 ? 0xFF : static_cast<uint8_t>(alpha));
     Color bColor = Color(0, 0, 0, 0);
     int x = x0;
 
@@ -140,7 +122,7 @@ int Font::drawText(const std::string &text, int x0, int y, int alpha) {
             }
             fColor = Color::getColorMap()[fontStr];
             if (alpha != -1)
-                fColor.a = (Uint8)alpha;
+                fColor.a = (uint8_t)alpha;
 
             continue;
         }
@@ -184,6 +166,8 @@ int Font::drawText(const std::string &text, int x0, int y, int alpha) {
 }
 
 int Font::drawText(const std::string &text, int x0, int y, Color bColor) {
+    PROFILE_ZONE("Font::drawText");
+    ALLOCATION_ZONE("Font::drawText");
     Color fColor = Color(0xFF, 0xFF, 0xFF);
     int x = x0;
 
@@ -247,12 +231,6 @@ int Font::drawText(const std::string &text, int x0, int y, Color bColor) {
     return 0;
 }
 
-int Font::getCellWidth() const { return mCellWidth; }
-
-int Font::getCellHeight() const { return mCellHeight; }
-
-Point Font::getCellSize() const { return {mCellWidth, mCellHeight}; }
-
 int Font::getFontStringLength(const std::string &text) {
     int characters = 0;
     for (std::string::size_type i = 0; i < text.length(); ++i) {
@@ -2,15 +2,14 @@
 #ifndef FONT_H_
 #define FONT_H_
 
-#include <SDL3/SDL.h>
-
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 struct Color;
+struct GlyphCommand;
 struct Point;
-class Texture;
 /// Height in pixels of each character on the character map
 const int CHAR_HEIGHT = 12; // 20; // 12;
 /// Width in pixels of each char
@@ -43,32 +42,26 @@ const std::string CHARS = // NOLINT(cert-err58-cpp)
     "endquote power2 block space3 "
     "bunny1 bunny2";
 
-/// This class describes a bitmap font texture coupled with an SDL_Renderer,
-/// allowing the drawing of complex colored text and symbols to the screen at
-/// any position
+/// This class describes a bitmap font, allowing the drawing of complex colored text and symbols at any position.
+/// Drawing only records the glyphs as GlyphCommands, which a RenderBackend then draws, so the game itself does not
+/// depend on any graphics library
 class Font {
-    /// The entire font texture
-    Texture &mTexture;
-    /// Width of each font cell in pixels
-    int mCellWidth;
-    /// Height of each font cell in pixels
-    int mCellHeight;
-    /// SDL_Renderer instance to render to
-    SDL_Renderer *mRenderer;
+    /// Where draws are appended, or nullptr to drop them
+    std::vector<GlyphCommand> *mRecording{nullptr};
 
   public:
     /// Map from each character's string representation (as in CHARS) to an (x, y)
     /// tuple of grid position within the font
     std::unordered_map<std::string, std::tuple<int, int>> characters;
 
-    /// Initialize a new font from the given texture, width of cell, height of
-    /// cell, number of cells per row, whitespace-separated characters in order of
-    /// appearance, and SDL_Renderer to render to
-    Font(Texture &texture, int cellWidth, int cellHeight, int numPerRow, const std::string &characters,
-         SDL_Renderer *renderer);
+    /// Initialize a new font from the number of cells per row of the font texture and the whitespace-separated
+    /// characters in order of appearance
+    Font(int numPerRow, const std::string &characters);
+
+    /// Record every glyph drawn into commands until it is changed again
+    /// \param commands where to append the glyphs, or nullptr to drop them
+    void setRecording(std::vector<GlyphCommand> *commands);
 
-    /// Set the font color via the underlying texture's color and alpha mod
-    void setFontColor(Color color);
     int draw(const std::string &character, int x, int y);
     int draw(const std::string &character, Point p);
     int draw(const std::string &character, int x, int y, Color fColor);
@@ -96,13 +89,6 @@ class Font {
     /// \return status code
     int drawText(const std::string &text, int x, int y, int alpha);
 
-    /// Get cell width
-    int getCellWidth() const;
-    /// Get cell height
-    int getCellHeight() const;
-    /// Get cell dimensions as Point (w, h)
-    Point getCellSize() const;
-
     /// Get number of actual characters in the font string (disregarding $(), $[], ${})
     static int getFontStringLength(const std::string &string);
 };
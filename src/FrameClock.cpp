@@ -0,0 +1,88 @@
+#include "FrameClock.h"
+
+#include <algorithm>
+#include <thread>
+
+const int FrameTimeHistogram::BUCKET_MICROSECONDS;
+const size_t FrameTimeHistogram::NUM_BUCKETS;
+const int FrameClock::SPIN_MICROSECONDS;
+
+void FrameTimeHistogram::add(double seconds) {
+    auto index = static_cast<size_t>(std::max(0.0, seconds) * 1e6 / BUCKET_MICROSECONDS);
+    ++mBuckets[std::min(index, NUM_BUCKETS - 1)];
+    ++mCount;
+}
+
+void FrameTimeHistogram::clear() {
+    mBuckets.fill(0);
+    mCount = 0;
+}
+
+double FrameTimeHistogram::getPercentile(double p) const {
+    if (mCount == 0)
+        return 0;
+
+    // Rank of the frame we want, counting from 1
+    auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * static_cast<double>(mCount) + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        seen += mBuckets[i];
+        if (seen >= rank)
+            return static_cast<double>((i + 1) * BUCKET_MICROSECONDS) / 1e6;
+    }
+    return static_cast<double>(NUM_BUCKETS * BUCKET_MICROSECONDS) / 1e6;
+}
+
+uint64_t FrameTimeHistogram::countLongerThan(double seconds) const {
+    auto first = static_cast<size_t>(std::max(0.0, seconds) * 1e6 / BUCKET_MICROSECONDS);
+    uint64_t count = 0;
+    for (size_t i = first; i < NUM_BUCKETS; ++i)
+        count += mBuckets[i];
+    return count;
+}
+
+FrameClock::FrameClock() : mEpoch(Clock::now()), mFrameStart(mEpoch), mDeadline(mEpoch) {}
+
+void FrameClock::setTargetFrameRate(int framesPerSecond) { mTargetFrameRate = std::max(1, framesPerSecond); }
+
+double FrameClock::now() const { return std::chrono::duration<double>(Clock::now() - mEpoch).count(); }
+
+void FrameClock::beginFrame() {
+    auto start = Clock::now();
+    if (mStarted) {
+        mDeltaSeconds = std::chrono::duration<double>(start - mFrameStart).count();
+        std::lock_guard<std::mutex> lock(mHistogramMutex);
+        mHistogram.add(mDeltaSeconds);
+    } else {
+        mDeadline = start;
+        mStarted = true;
+    }
+    mFrameStart = start;
+}
+
+double FrameClock::getElapsedSeconds() const {
+    return std::chrono::duration<double>(Clock::now() - mFrameStart).count();
+}
+
+void FrameClock::waitForNextFrame() {
+    mDeadline += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / mTargetFrameRate));
+
+    auto current = Clock::now();
+    if (mPacing == Pacing::VSYNC || mDeadline <= current) {
+        // Start the next frame's deadline from now, so a slow frame isn't followed by a burst of unpaced ones
+        if (mDeadline < current)
+            mDeadline = current;
+        return;
+    }
+
+    auto spinFrom = mDeadline - std::chrono::microseconds(SPIN_MICROSECONDS);
+    if (current < spinFrom)
+        std::this_thread::sleep_until(spinFrom);
+    while (Clock::now() < mDeadline)
+        std::this_thread::yield();
+}
+
+FrameTimeHistogram FrameClock::getHistogram() const {
+    std::lock_guard<std::mutex> lock(mHistogramMutex);
+    return mHistogram;
+}
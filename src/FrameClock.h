@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/// Counts frame times into buckets of BUCKET_MICROSECONDS, so that the distribution of a whole session can be kept in a
+/// fixed amount of memory
+class FrameTimeHistogram {
+  public:
+    /// Width of each bucket
+    static const int BUCKET_MICROSECONDS = 500;
+    /// Number of buckets. Frames longer than the last bucket's lower bound all go in the last bucket
+    static const size_t NUM_BUCKETS = 100;
+
+    /// Count a frame that took seconds
+    void add(double seconds);
+    void clear();
+
+    /// Number of frames counted
+    uint64_t getCount() const { return mCount; }
+    /// Number of frames in the bucket at index
+    uint64_t getBucket(size_t index) const { return mBuckets[index]; }
+    /// Get the upper bound in seconds of the bucket holding the p-th percentile frame, where p is between 0 and 1
+    double getPercentile(double p) const;
+    /// Number of frames that took longer than seconds, to the nearest bucket
+    uint64_t countLongerThan(double seconds) const;
+
+  private:
+    std::array<uint64_t, NUM_BUCKETS> mBuckets{};
+    uint64_t mCount{0};
+};
+
+/// Monotonic wall-clock time for the whole game. The render thread starts each frame with beginFrame() and paces frames
+/// with waitForNextFrame(), which sleeps until the frame's deadline rather than for a fixed time, so the frame rate
+/// holds however long drawing took. Other systems read now() to time animations and fades independently of how often
+/// they are called
+class FrameClock {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// How frames are kept to the target frame rate
+    enum class Pacing {
+        /// Sleep until each frame's deadline
+        SLEEP,
+        /// Presenting a frame waits for the display's vertical sync, or the browser schedules frames, so never sleep
+        VSYNC
+    };
+
+    /// Get the singleton instance
+    static FrameClock &getInstance() {
+        static FrameClock instance;
+        return instance;
+    }
+
+    FrameClock(const FrameClock &) = delete;
+    void operator=(const FrameClock &) = delete;
+
+    void setTargetFrameRate(int framesPerSecond);
+    int getTargetFrameRate() const { return mTargetFrameRate; }
+    void setPacing(Pacing pacing) { mPacing = pacing; }
+    Pacing getPacing() const { return mPacing; }
+
+    /// Seconds since the clock was created. Safe to call from any thread
+    double now() const;
+
+    /// Start a frame, recording the time since the last frame started in the histogram
+    void beginFrame();
+    /// Seconds since the current frame started
+    double getElapsedSeconds() const;
+    /// Seconds between the starts of the last two frames, including any sleep
+    double getDeltaSeconds() const { return mDeltaSeconds; }
+    /// Sleep until the current frame's deadline, unless the frame is already late or pacing is VSYNC. A late frame
+    /// moves the deadlines back rather than hurrying the frames after it
+    void waitForNextFrame();
+
+    /// Get a copy of the times between frame starts since the game started. Safe to call from any thread
+    FrameTimeHistogram getHistogram() const;
+
+  private:
+    FrameClock();
+
+    /// Start sleeping this long before a deadline and spin for the rest, as sleeps can overshoot by about a scheduler
+    /// time slice
+    static const int SPIN_MICROSECONDS = 1000;
+
+    Clock::time_point mEpoch;
+    int mTargetFrameRate{60};
+#ifdef __EMSCRIPTEN__
+    Pacing mPacing{Pacing::VSYNC};
+#else
+    Pacing mPacing{Pacing::SLEEP};
+#endif
+
+    Clock::time_point mFrameStart;
+    Clock::time_point mDeadline;
+    double mDeltaSeconds{0};
+    bool mStarted{false};
+
+    /// Guards the histogram, which the simulation thread reads for the performance overlay
+    mutable std::mutex mHistogramMutex;
+    FrameTimeHistogram mHistogram;
+};
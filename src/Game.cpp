@@ -1,4 +1,7 @@
 #include "Game.h"
+#include "AllocationCounter.h"
+#include "Animation/AnimationSystem.h"
+#include "Arena.h"
 #include "Entity/Building/BuildingWallEntity.h"
 #include "Entity/ChestEntity.h"
 #include "Entity/Entity.h"
@@ -9,24 +12,35 @@
 #include "Entity/Items/WaterskinEntity.h"
 #include "Entity/NPCs/CatEntity.h"
 #include "EntityBuilder.h"
+#include "FrameClock.h"
+#include "PerformanceStats.h"
+#include "Profiler.h"
 #include "Property/Properties/PickuppableProperty.h"
 #include "UI/MessageBoxRenderer.h"
 #include "UI/NotificationMessageRenderer.h"
-#include "utils.h"
+#include "UI/PerformanceOverlayRenderer.h"
 
 #include <deque>
 
-Game::Game()
-    : mSDLManager(SDL_INIT_VIDEO), m_lightMapTexture(mSDLManager.getRenderer()), mFontTexture(makeFontTexture()),
-      m_font(*mFontTexture, CHAR_WIDTH, CHAR_HEIGHT, NUM_PER_ROW, CHARS, mSDLManager.getRenderer()),
+Game::Game(GameOptions options)
+    : mSDLManager(SDL_INIT_VIDEO), mRenderBackend(mSDLManager.getRenderer()), m_font(NUM_PER_ROW, CHARS),
+      mRecordingFont(NUM_PER_ROW, CHARS),
       m_player(makePlayer()), m_screens(*m_player),
-      m_initialMessageLines({"Welcome to the game", "? for help (once you've closed this)", "return to start"}) {
-    srand(static_cast<unsigned int>(time(NULL)));
-    SDL_Renderer *renderer = mSDLManager.getRenderer();
-
-    m_renderTexture =
-        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_BGRA32, SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
-    SDL_SetTextureBlendMode(m_renderTexture, SDL_BLENDMODE_BLEND);
+      m_initialMessageLines({"Welcome to the game", "? for help (once you've closed this)", "return to start"}),
+      mPlayback(std::move(options.mPlayback)), mRecorder(std::move(options.mRecorder)), mFast(options.mFast),
+      mHeadless(options.mHeadless), mTracePath(std::move(options.mTracePath)) {
+    Profiler::getInstance().setThreadName("Render");
+    if (!mTracePath.empty())
+        Profiler::getInstance().setRecording(true);
+
+    auto &clock = FrameClock::getInstance();
+    clock.setTargetFrameRate(MAX_FRAME_RATE);
+    if (options.mVSync) {
+        if (mRenderBackend.setVSync(true))
+            clock.setPacing(FrameClock::Pacing::VSYNC);
+        else
+            SDL_Log("Could not enable VSync, so sleeping between frames instead: %s", SDL_GetError());
+    }
 
     auto &manager = EntityManager::getInstance();
 
@@ -67,9 +81,29 @@ Game::Game()
 
     manager.initialize();
     manager.setTimeOfDay(Time(6, 0));
+
+    mBackSnapshot = std::make_shared<RenderSnapshot>();
+#ifndef __EMSCRIPTEN__
+    // From here on the simulation thread owns the world, the entities and the UI
+    mSimulationThread = std::thread(&Game::simulate, this);
+#endif
 }
 
-Game::~Game() { SDL_DestroyTexture(m_renderTexture); }
+Game::~Game() {
+    mQuit = true;
+#ifndef __EMSCRIPTEN__
+    mInputCondition.notify_one();
+    if (mSimulationThread.joinable())
+        mSimulationThread.join();
+#endif
+    // The simulation has stopped, so the world can be read from this thread
+    if (mRecorder != nullptr) {
+        auto &manager = EntityManager::getInstance();
+        mRecorder->finish(manager.getTickCount(), manager.computeStateHash());
+    }
+    if (!mTracePath.empty())
+        writeTrace();
+}
 
 bool Game::processEvent(SDL_Event *e) {
     if (e->type == SDL_EVENT_QUIT)
@@ -78,39 +112,143 @@ bool Game::processEvent(SDL_Event *e) {
         mSDLManager.rescaleWindow(1.1);
     } else if (e->type == SDL_EVENT_KEY_DOWN && e->key.mod & SDL_KMOD_CTRL && e->key.key == SDLK_MINUS) {
         mSDLManager.rescaleWindow(0.9);
-    } else if (m_initialMessage && e->type == SDL_EVENT_KEY_DOWN && e->key.key == SDLK_RETURN)
-        m_initialMessage = false;
-    else if (!m_initialMessage && e->type == SDL_EVENT_KEY_DOWN) {
-        bool screenEnabled = false;
-        for (auto &screen : m_screens.getScreens()) {
-            if (screen.second->isEnabled()) {
-                screen.second->handleInput(e->key);
-                screenEnabled = true;
-                break;
-            }
+    } else if (e->type == SDL_EVENT_KEY_DOWN && e->key.mod & SDL_KMOD_CTRL && e->key.key == SDLK_P &&
+               !mTracePath.empty()) {
+        writeTrace();
+    } else if (e->type == SDL_EVENT_KEY_DOWN) {
+        // Everything else is handled by the simulation
+        {
+            std::lock_guard<std::mutex> lock(mInputMutex);
+            mInputQueue.push_back(KeyEvent{e->key.key, e->key.mod});
         }
-        if (!screenEnabled) {
-            bool quit = false;
-            dynamic_cast<PlayerEntity &>(*m_player).handleInput(e->key, quit, m_screens.getScreens());
-            if (quit) {
-                return true;
-            }
+        mInputCondition.notify_one();
+    }
+    return shouldQuit();
+}
+
+bool Game::shouldQuit() const { return mQuit; }
+
+void Game::simulate() {
+    Profiler::getInstance().setThreadName("Simulation");
+    std::vector<KeyEvent> events;
+    while (!mQuit) {
+        {
+            std::unique_lock<std::mutex> lock(mInputMutex);
+            // Step as soon as there is input, otherwise keep recording at the frame rate so that UI such as fading
+            // notifications still updates. Played back keys are handled one per frame, or back to back if fast
+            const bool fastPlayback = mPlayback != nullptr && mFast;
+            mInputCondition.wait_for(lock, std::chrono::microseconds(fastPlayback ? 0 : 1000000 / MAX_FRAME_RATE),
+                                     [this] { return (mPlayback == nullptr && !mInputQueue.empty()) || mQuit; });
+            events.swap(mInputQueue);
         }
+        if (mPlayback != nullptr)
+            playBackKey(events);
+        step(events);
+        events.clear();
     }
-    return false;
+
+    // The recording may have ended by quitting
+    if (mPlayback != nullptr)
+        finishPlayback();
 }
 
-void Game::iterate() {
-    beginTime();
+void Game::playBackKey(std::vector<KeyEvent> &events) {
+    // Keys pressed during playback are ignored, since they would not be in the recording
+    events.clear();
+
+    RecordedKey recorded{};
+    if (!mPlayback->next(recorded)) {
+        finishPlayback();
+        return;
+    }
 
-    auto renderer = mSDLManager.getRenderer();
-    SDL_SetRenderTarget(renderer, m_renderTexture);
+    auto tick = EntityManager::getInstance().getTickCount();
+    if (recorded.mTick != tick && !mPlaybackDiverged) {
+        SDL_Log("Playback diverged at key %zu: recorded at tick %lu but handled at tick %lu", mPlayback->getNumPlayed(),
+                recorded.mTick, tick);
+        mPlaybackDiverged = true;
+    }
+
+    events.push_back(KeyEvent{recorded.mKey, recorded.mMod});
+}
 
+void Game::finishPlayback() {
     auto &manager = EntityManager::getInstance();
-    manager.cleanup();
+    auto tick = manager.getTickCount();
+    SDL_Log("Played back %zu of %zu keys, finishing at tick %lu", mPlayback->getNumPlayed(), mPlayback->getNumKeys(),
+            tick);
+
+    if (mPlayback->hasFinalState()) {
+        auto stateHash = manager.computeStateHash();
+        if (mPlayback->isFinished() && tick == mPlayback->getFinalTick() && stateHash == mPlayback->getFinalStateHash())
+            SDL_Log("Playback finished in the same state as the recording");
+        else
+            SDL_Log("Playback finished in state %016llx at tick %lu, but the recording finished in state %016llx at "
+                    "tick %lu",
+                    static_cast<unsigned long long>(stateHash), tick,
+                    static_cast<unsigned long long>(mPlayback->getFinalStateHash()), mPlayback->getFinalTick());
+    }
+
+    mPlayback.reset();
+    if (mHeadless)
+        mQuit = true;
+}
+
+void Game::writeTrace() {
+    if (Profiler::getInstance().writeChromeTrace(mTracePath))
+        SDL_Log("Wrote profiler trace to %s", mTracePath.c_str());
+    else
+        SDL_Log("Could not write profiler trace to %s", mTracePath.c_str());
+}
+
+void Game::step(std::vector<KeyEvent> &events) {
+    PROFILE_ZONE("Game::step");
+    ALLOCATION_ZONE("Game::step");
+    {
+        PhaseTimer timer(FramePhase::SIMULATE);
+        for (auto &key : events) {
+            handleKey(key);
+            if (mQuit)
+                return;
+        }
+    }
+
+    recordSnapshot(*mBackSnapshot);
+    publishSnapshot();
+}
+
+void Game::handleKey(KeyEvent &key) {
+    if (mRecorder != nullptr)
+        mRecorder->record(EntityManager::getInstance().getTickCount(), key.mKey, key.mMod);
+
+    if (m_initialMessage) {
+        if (key.mKey == KEY_RETURN)
+            m_initialMessage = false;
+        return;
+    }
 
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0xFF);
-    SDL_RenderClear(renderer);
+    for (auto &screen : m_screens.getScreens()) {
+        if (screen.second->isEnabled()) {
+            screen.second->handleInput(key);
+            return;
+        }
+    }
+
+    bool quit = false;
+    dynamic_cast<PlayerEntity &>(*m_player).handleInput(key, quit, m_screens.getScreens());
+    if (quit)
+        mQuit = true;
+}
+
+void Game::recordSnapshot(RenderSnapshot &snapshot) {
+    PROFILE_ZONE("Game::recordSnapshot");
+    ALLOCATION_ZONE("Game::recordSnapshot");
+    snapshot.clear();
+    // Scratch data from recording the last snapshot, and from handling input since, is no longer needed
+    Arena::getFrameArena().reset();
+
+    auto &manager = EntityManager::getInstance();
+    manager.cleanup();
 
     bool shouldRenderWorld = true;
     Screen *screenToRender = nullptr;
@@ -122,17 +260,34 @@ void Game::iterate() {
         }
     }
 
+    mRecordingFont.setRecording(&snapshot.mWorldGlyphs);
     if (shouldRenderWorld) {
-        m_world.render(m_font, m_player->getWorldPos());
-        manager.render(m_font, m_player->getWorldPos(), m_lightMapTexture);
+        {
+            PhaseTimer timer(FramePhase::WORLD_RENDER);
+            manager.updateFieldOfView();
+            m_world.render(mRecordingFont, m_player->getWorldPos(), manager.getFieldOfView());
+        }
+        {
+            PhaseTimer timer(FramePhase::ENTITY_RENDER);
+            AnimationSystem::getInstance().update(FrameClock::getInstance().now(), manager.getFieldOfView());
+            manager.render(mRecordingFont, m_player->getWorldPos());
+        }
+
+        snapshot.mRenderWorld = true;
+        snapshot.mLights = manager.getCurrentLightSources();
+        snapshot.mLightMapAlpha = manager.getLightMapAlpha();
     }
 
+    // Everything else is drawn over the light map
+    mRecordingFont.setRecording(&snapshot.mUIGlyphs);
+    PhaseTimer timer(FramePhase::UI);
+
     // Always render status and notification UI
-    m_pStatusUI->render(m_font, m_player->getWorldPos());
-    NotificationMessageRenderer::getInstance().render(m_font);
+    m_pStatusUI->render(mRecordingFont, m_player->getWorldPos());
+    NotificationMessageRenderer::getInstance().render(mRecordingFont);
 
     if (screenToRender != nullptr) {
-        screenToRender->render(m_font);
+        screenToRender->render(mRecordingFont);
     }
 
     if (m_player->mHp <= 0) {
@@ -143,24 +298,80 @@ void Game::iterate() {
     if (m_initialMessage)
         MessageBoxRenderer::getInstance().queueMessageBoxCentered(m_initialMessageLines, 1);
 
-    MessageBoxRenderer::getInstance().render(m_font);
+    PerformanceOverlayRenderer::getInstance().render(mRecordingFont);
+    MessageBoxRenderer::getInstance().render(mRecordingFont);
 
+    mRecordingFont.setRecording(nullptr);
+}
+
+void Game::publishSnapshot() {
+    std::lock_guard<std::mutex> lock(mSnapshotMutex);
+    std::shared_ptr<const RenderSnapshot> previous = std::move(mFrontSnapshot);
+    mFrontSnapshot = std::move(mBackSnapshot);
+
+    // Record the next snapshot into the previous one if the render thread is done with it, so that the two buffers
+    // are reused and recording does not allocate. The render thread releases its snapshot under the same lock, so
+    // the count is exact here
+    if (previous != nullptr && previous.use_count() == 1)
+        mBackSnapshot = std::const_pointer_cast<RenderSnapshot>(previous);
+    else
+        mBackSnapshot = std::make_shared<RenderSnapshot>();
+}
+
+void Game::renderSnapshot(const RenderSnapshot &snapshot) {
+    PROFILE_ZONE("Game::renderSnapshot");
+    ALLOCATION_ZONE("Game::renderSnapshot");
+    {
+        PhaseTimer timer(FramePhase::PRESENT);
+        mRenderBackend.beginFrame();
+    }
+    mRenderBackend.drawSnapshot(snapshot);
+
+    PhaseTimer timer(FramePhase::PRESENT);
+    mFrameRateGlyphs.clear();
+    m_font.setRecording(&mFrameRateGlyphs);
     m_font.drawText(std::to_string(m_fps), World::SCREEN_WIDTH - 5, World::SCREEN_HEIGHT - 1);
+    m_font.setRecording(nullptr);
+    mRenderBackend.drawGlyphs(mFrameRateGlyphs);
 
-    SDL_SetRenderTarget(renderer, nullptr);
-    SDL_RenderTexture(renderer, m_renderTexture, nullptr, nullptr);
+    mRenderBackend.endFrame();
+}
 
-    SDL_RenderPresent(renderer);
+void Game::iterate() {
+    auto &clock = FrameClock::getInstance();
+    clock.beginFrame();
+
+#ifdef __EMSCRIPTEN__
+    // No threads, so step the simulation here before drawing
+    std::vector<KeyEvent> events;
+    events.swap(mInputQueue);
+    step(events);
+#endif
+
+    std::shared_ptr<const RenderSnapshot> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mSnapshotMutex);
+        snapshot = mFrontSnapshot;
+    }
 
-    // Cap framerate
-    auto frameTimeBeforeCap = endTime();
+    // Nothing has been simulated yet
+    if (snapshot != nullptr && !mHeadless)
+        renderSnapshot(*snapshot);
 
-    auto secondsTooFastBy = 1.0 / MAX_FRAME_RATE - frameTimeBeforeCap;
-    if (secondsTooFastBy > 0) {
-        SDL_Delay(static_cast<Uint32>(secondsTooFastBy * 1000));
+    {
+        std::lock_guard<std::mutex> lock(mSnapshotMutex);
+        snapshot.reset();
     }
 
-    m_frameTimes.push_back(static_cast<float>(frameTimeBeforeCap + (secondsTooFastBy > 0 ? secondsTooFastBy : 0)));
+    PerformanceStats::getInstance().endFrame(clock.getElapsedSeconds());
+
+    // Cap framerate
+    clock.waitForNextFrame();
+
+    // The first frame has no frame before it to measure from
+    if (clock.getDeltaSeconds() <= 0)
+        return;
+    m_frameTimes.push_back(static_cast<float>(clock.getDeltaSeconds()));
     m_totalTime += m_frameTimes.back();
 
     if (m_frameTimes.size() > 60) {
@@ -171,13 +382,6 @@ void Game::iterate() {
     m_fps = m_frameTimes.size() / m_totalTime;
 }
 
-std::unique_ptr<Texture> Game::makeFontTexture() {
-    auto fontTexture = std::make_unique<Texture>(mSDLManager.getRenderer());
-    //    mFontTexture->loadFromFile("resources/curses_800x600.bmp");
-    fontTexture->loadFromFile(std::string(SDL_GetBasePath()) + "resources/cursesV2_800x600.bmp");
-    return fontTexture;
-}
-
 PlayerEntity *Game::makePlayer() {
     auto player = EntityBuilder::makeEntity<PlayerEntity>();
     // Place player in center of world
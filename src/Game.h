@@ -3,45 +3,129 @@
 
 #include "Entity/UI/StatusUIEntity.h"
 #include "Font.h"
-#include "LightMapTexture.h"
+#include "InputRecording.h"
+#include "KeyEvent.h"
+#include "RenderSnapshot.h"
 #include "SDLManager.h"
+#include "SDLRenderBackend.h"
 #include "UI/Screens/Screens.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 const int MAX_FRAME_RATE = 30;
 
+/// How the game was started from the command line
+struct GameOptions {
+    /// Keys to handle instead of the keyboard's until they run out, or nullptr to play normally
+    std::unique_ptr<InputPlayback> mPlayback;
+    /// Where to record the keys the game handles, or nullptr to not record
+    std::unique_ptr<InputRecorder> mRecorder;
+    /// Play back keys as fast as possible instead of one per frame
+    bool mFast{false};
+    /// Don't draw to the window, and quit once playback has finished
+    bool mHeadless{false};
+    /// Where to write a Chrome trace of the profiled zones, or empty to not profile
+    std::string mTracePath;
+    /// Pace frames with the display's vertical sync instead of sleeping
+    bool mVSync{false};
+};
+
+/// Owns the window, the world and the player.
+/// The simulation (input handling, ticking and recording what to draw) runs on its own thread and publishes a
+/// RenderSnapshot after each step. The render thread (the thread calling iterate()) only ever draws the latest
+/// published snapshot, so a slow tick never drops frames and drawing never delays input. When built with Emscripten
+/// there are no threads and iterate() steps the simulation itself before drawing.
+/// The keys handled by the simulation can be recorded and played back, which reproduces the game exactly as long as it
+/// is started with the same world seed
 class Game {
   public:
-    Game();
+    explicit Game(GameOptions options);
     ~Game();
 
+    /// Draw the latest snapshot to the window
     void iterate();
+    /// Handle an SDL event on the main thread, queueing key presses for the simulation. Ctrl+P writes out the profiled
+    /// zones so far when tracing
+    /// \return whether the game should quit
     bool processEvent(SDL_Event *e);
+    /// Has the simulation asked to quit?
+    bool shouldQuit() const;
 
   private:
-    std::unique_ptr<Texture> makeFontTexture();
     PlayerEntity *makePlayer();
 
+    /// Main loop of the simulation thread
+    void simulate();
+    /// Handle the given key presses, then record and publish a snapshot of the game
+    void step(std::vector<KeyEvent> &events);
+    /// Pass a key press to the open screen, or else to the player
+    void handleKey(KeyEvent &key);
+    /// Take the next played back key press into events, or finish playback if there are none left
+    void playBackKey(std::vector<KeyEvent> &events);
+    /// Report whether playback reached the same state as the recording, then stop playing back
+    void finishPlayback();
+    /// Write the profiled zones to mTracePath
+    void writeTrace();
+    /// Draw the whole game into snapshot using the recording font
+    void recordSnapshot(RenderSnapshot &snapshot);
+    /// Make mBackSnapshot the latest snapshot and pick a buffer to record the next one into
+    void publishSnapshot();
+    /// Draw snapshot to the window, along with the frame rate
+    void renderSnapshot(const RenderSnapshot &snapshot);
+
     SDLManager mSDLManager;
-    LightMapTexture m_lightMapTexture;
-    std::unique_ptr<Texture> mFontTexture{nullptr};
+    SDLRenderBackend mRenderBackend;
+    /// Font used by the render thread to record the frame rate
     Font m_font;
+    /// The frame rate, drawn over the snapshot
+    std::vector<GlyphCommand> mFrameRateGlyphs;
+    /// Font used by the simulation thread, which only ever records glyphs into snapshots
+    Font mRecordingFont;
     World m_world;
     PlayerEntity *m_player;
     Screens m_screens;
 
-    SDL_Texture *m_renderTexture;
-
     StatusUIEntity *m_pStatusUI;
 
     std::vector<std::string> m_initialMessageLines;
 
+    /// Times between the latest frames, averaged for the frame rate
     std::deque<float> m_frameTimes;
     float m_totalTime = 0;
     float m_fps = 60;
 
     bool m_initialMessage = true;
+
+    /// Key presses waiting for the simulation
+    std::vector<KeyEvent> mInputQueue;
+    std::mutex mInputMutex;
+    std::condition_variable mInputCondition;
+
+    /// Guards swapping mFrontSnapshot and releasing it on the render thread
+    std::mutex mSnapshotMutex;
+    /// Latest published snapshot, never modified
+    std::shared_ptr<const RenderSnapshot> mFrontSnapshot;
+    /// Snapshot the simulation records into next
+    std::shared_ptr<RenderSnapshot> mBackSnapshot;
+
+    /// Keys being played back, reset once they run out
+    std::unique_ptr<InputPlayback> mPlayback;
+    std::unique_ptr<InputRecorder> mRecorder;
+    bool mFast;
+    bool mHeadless;
+    std::string mTracePath;
+    /// Has a played back key been handled at a different tick than it was recorded at?
+    bool mPlaybackDiverged{false};
+
+    std::atomic<bool> mQuit{false};
+#ifndef __EMSCRIPTEN__
+    std::thread mSimulationThread;
+#endif
 };
 
 #endif // SURVIVAL_GAME_H
@@ -0,0 +1,130 @@
+#include "InputRecording.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+const char MAGIC[4] = {'S', 'V', 'R', 'C'};
+const char VERSION = 1;
+/// Tags of the records following the header
+const char KEY_RECORD = 'K';
+const char END_RECORD = 'E';
+
+/// Reads the little-endian and variable length integers that InputRecorder writes
+class Reader {
+  public:
+    explicit Reader(const std::vector<char> &data) : mData(data) {}
+
+    bool atEnd() const { return mPos >= mData.size(); }
+
+    bool readByte(char &value) {
+        if (atEnd())
+            return false;
+        value = mData[mPos++];
+        return true;
+    }
+
+    bool readFixed64(uint64_t &value) {
+        if (mData.size() - mPos < 8)
+            return false;
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(mData[mPos++])) << (8 * i);
+        return true;
+    }
+
+    bool readVarint(uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            char byte;
+            if (!readByte(byte))
+                return false;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+  private:
+    const std::vector<char> &mData;
+    size_t mPos{0};
+};
+} // namespace
+
+InputRecorder::InputRecorder(const std::string &path, uint64_t worldSeed)
+    : mFile(path, std::ios::binary | std::ios::trunc) {
+    mFile.write(MAGIC, sizeof(MAGIC));
+    mFile.put(VERSION);
+    for (int i = 0; i < 8; ++i)
+        mFile.put(static_cast<char>((worldSeed >> (8 * i)) & 0xFF));
+    mFile.flush();
+}
+
+void InputRecorder::record(unsigned long tick, Keycode key, Keymod mod) {
+    mFile.put(KEY_RECORD);
+    writeVarint(tick - mLastTick);
+    writeVarint(key);
+    writeVarint(mod);
+    mFile.flush();
+    mLastTick = tick;
+}
+
+void InputRecorder::finish(unsigned long tick, uint64_t stateHash) {
+    mFile.put(END_RECORD);
+    writeVarint(tick);
+    for (int i = 0; i < 8; ++i)
+        mFile.put(static_cast<char>((stateHash >> (8 * i)) & 0xFF));
+    mFile.flush();
+}
+
+void InputRecorder::writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+        mFile.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    mFile.put(static_cast<char>(value));
+}
+
+InputPlayback::InputPlayback(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return;
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader reader(data);
+    char magic[sizeof(MAGIC)];
+    for (auto &byte : magic) {
+        if (!reader.readByte(byte))
+            return;
+    }
+    char version;
+    if (!std::equal(magic, magic + sizeof(MAGIC), MAGIC) || !reader.readByte(version) || version != VERSION ||
+        !reader.readFixed64(mWorldSeed))
+        return;
+    mOpen = true;
+
+    // A recording cut short by a crash has no end record and may end part way through a key, which is dropped
+    unsigned long tick = 0;
+    char tag;
+    while (reader.readByte(tag)) {
+        uint64_t delta, key, mod;
+        if (tag == KEY_RECORD && reader.readVarint(delta) && reader.readVarint(key) && reader.readVarint(mod)) {
+            tick += static_cast<unsigned long>(delta);
+            mKeys.push_back({tick, static_cast<Keycode>(key), static_cast<Keymod>(mod)});
+        } else if (tag == END_RECORD && reader.readVarint(delta) && reader.readFixed64(mFinalStateHash)) {
+            mFinalTick = static_cast<unsigned long>(delta);
+            mHasFinalState = true;
+            break;
+        } else {
+            break;
+        }
+    }
+}
+
+bool InputPlayback::next(RecordedKey &key) {
+    if (isFinished())
+        return false;
+    key = mKeys[mNext++];
+    return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "KeyEvent.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// A key press handled by the game, and the tick the game was at when it was handled
+struct RecordedKey {
+    unsigned long mTick;
+    Keycode mKey;
+    Keymod mMod;
+};
+
+/// Writes the world seed and every key press handled by the game to a file, so that the session can be played back.
+/// Each key is stored as a tag byte and three variable length integers: the number of ticks since the previous key,
+/// the key code and the modifiers, which is four bytes for most keys. The file is flushed after every key, so that a
+/// session that crashes can still be replayed
+class InputRecorder {
+  public:
+    /// Start a recording at path, overwriting any existing file
+    /// \param worldSeed seed of the random streams that the game was started with
+    InputRecorder(const std::string &path, uint64_t worldSeed);
+
+    /// Could the file be opened for writing?
+    bool isOpen() const { return mFile.good(); }
+
+    /// Record a key press, which must be at the same tick or later than the previous one
+    void record(unsigned long tick, Keycode key, Keymod mod);
+
+    /// End the recording with the state the game finished in, so that playback can check it finishes in the same one
+    /// \param tick tick count at the end of the session
+    /// \param stateHash EntityManager::computeStateHash() at the end of the session
+    void finish(unsigned long tick, uint64_t stateHash);
+
+  private:
+    void writeVarint(uint64_t value);
+
+    std::ofstream mFile;
+    unsigned long mLastTick{0};
+};
+
+/// Reads back a file written by InputRecorder
+class InputPlayback {
+  public:
+    /// Read the whole recording at path. Check isOpen() before using it
+    explicit InputPlayback(const std::string &path);
+
+    /// Was the file read successfully?
+    bool isOpen() const { return mOpen; }
+
+    /// Seed that the recorded game was started with
+    uint64_t getWorldSeed() const { return mWorldSeed; }
+
+    /// Get the next recorded key press
+    /// \return false if every key has been played back
+    bool next(RecordedKey &key);
+    /// Have all the key presses been played back?
+    bool isFinished() const { return mNext == mKeys.size(); }
+    /// Number of key presses played back so far
+    size_t getNumPlayed() const { return mNext; }
+    /// Number of key presses in the recording
+    size_t getNumKeys() const { return mKeys.size(); }
+
+    /// Did the recording end cleanly, with the state the game finished in?
+    bool hasFinalState() const { return mHasFinalState; }
+    unsigned long getFinalTick() const { return mFinalTick; }
+    uint64_t getFinalStateHash() const { return mFinalStateHash; }
+
+  private:
+    bool mOpen{false};
+    uint64_t mWorldSeed{0};
+    std::vector<RecordedKey> mKeys;
+    size_t mNext{0};
+
+    bool mHasFinalState{false};
+    unsigned long mFinalTick{0};
+    uint64_t mFinalStateHash{0};
+};
@@ -0,0 +1,51 @@
+#include "Intents.h"
+
+#include "Entity/Entity.h"
+#include "EventBus.h"
+#include "Events.h"
+#include "UI/NotificationMessageRenderer.h"
+
+void Intents::moveTo(const Point &pos) {
+    mIntents.emplace_back(Intent::Type::MOVE);
+    mIntents.back().mPos = pos;
+}
+
+void Intents::attack(Entity &target, int damage) {
+    mIntents.emplace_back(Intent::Type::ATTACK);
+    mIntents.back().mTarget = &target;
+    mIntents.back().mDamage = damage;
+}
+
+void Intents::notify(std::string message) {
+    mIntents.emplace_back(Intent::Type::NOTIFY);
+    mIntents.back().mMessage = std::move(message);
+}
+
+void Intents::then(std::function<void()> action) {
+    mIntents.emplace_back(Intent::Type::CALL);
+    mIntents.back().mAction = std::move(action);
+}
+
+void Intents::apply(Entity &entity) {
+    for (auto &intent : mIntents) {
+        switch (intent.mType) {
+        case Intent::Type::MOVE:
+            // Fails if another entity got there first
+            entity.moveTo(intent.mPos);
+            break;
+        case Intent::Type::ATTACK:
+            intent.mTarget->mHp -= intent.mDamage;
+            intent.mTarget->wake();
+            EventBus::getInstance().publish(intent.mTarget->getWorldPos(),
+                                            AttackEvent{entity.mID, intent.mTarget->mID, intent.mDamage});
+            break;
+        case Intent::Type::NOTIFY:
+            NotificationMessageRenderer::getInstance().queueMessage(intent.mMessage);
+            break;
+        case Intent::Type::CALL:
+            intent.mAction();
+            break;
+        }
+    }
+    mIntents.clear();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Point.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+struct Entity;
+/// Changes to the world that an entity's behaviours decided on while planning in parallel with other entities. They are
+/// applied one entity at a time in a fixed order once every entity has planned, so that conflicts such as two entities
+/// moving to the same cell are settled the same way however many threads planned
+class Intents {
+  public:
+    /// Move the entity to pos, if nothing has moved there first
+    void moveTo(const Point &pos);
+    /// Deal damage to target, which must still be managed when the intents are applied
+    void attack(Entity &target, int damage);
+    /// Queue a notification message for the player
+    void notify(std::string message);
+    /// Run any other change to the world, e.g. enabling a behaviour or changing another entity
+    void then(std::function<void()> action);
+
+    /// Apply the intents to the world in the order they were added, and then clear them
+    /// \param entity the entity that planned the intents
+    void apply(Entity &entity);
+
+    bool empty() const { return mIntents.empty(); }
+
+  private:
+    struct Intent {
+        enum class Type { MOVE, ATTACK, NOTIFY, CALL };
+
+        explicit Intent(Type type) : mType(type) {}
+
+        Type mType;
+        Point mPos;
+        Entity *mTarget{nullptr};
+        int mDamage{0};
+        std::string mMessage;
+        std::function<void()> mAction;
+    };
+
+    std::vector<Intent> mIntents;
+};
@@ -0,0 +1,191 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+/// Job system that the current thread is a worker of, if any
+thread_local JobSystem *tJobSystem = nullptr;
+/// Index of the current thread in tJobSystem's workers
+thread_local unsigned tWorkerIndex = 0;
+} // namespace
+
+JobSystem::JobSystem(unsigned numWorkers) { startWorkers(numWorkers); }
+
+JobSystem::~JobSystem() { stopWorkers(); }
+
+unsigned JobSystem::defaultNumWorkers() {
+#ifdef __EMSCRIPTEN__
+    return 0;
+#else
+    auto numThreads = std::thread::hardware_concurrency();
+    return numThreads > 1 ? numThreads - 1 : 0;
+#endif
+}
+
+void JobSystem::setNumWorkers(unsigned numWorkers) {
+    stopWorkers();
+    startWorkers(numWorkers);
+}
+
+void JobSystem::startWorkers(unsigned numWorkers) {
+#ifdef __EMSCRIPTEN__
+    numWorkers = 0;
+#endif
+    // Create every queue before starting any thread, as workers steal from all of them
+    for (unsigned i = 0; i < numWorkers; ++i)
+        mWorkers.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < numWorkers; ++i)
+        mWorkers[i]->mThread = std::thread(&JobSystem::work, this, i);
+}
+
+void JobSystem::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStopping = true;
+    }
+    mJobQueued.notify_all();
+    for (auto &worker : mWorkers)
+        worker->mThread.join();
+    mWorkers.clear();
+    mStopping = false;
+}
+
+void JobSystem::submit(Job job, TaskGroup &group) {
+    ++group.mPending;
+
+    // Workers push onto their own queue so that forked jobs stay hot in its cache, other threads spread their jobs out
+    auto index = tJobSystem == this ? tWorkerIndex : mNextQueue++ % getNumWorkers();
+    {
+        std::lock_guard<std::mutex> lock(mWorkers[index]->mMutex);
+        mWorkers[index]->mJobs.emplace_back(std::move(job), &group);
+    }
+
+    // Count the job before taking the lock so that a worker about to sleep either sees it or is notified
+    ++mQueuedJobs;
+    { std::lock_guard<std::mutex> lock(mSleepMutex); }
+    mJobQueued.notify_one();
+}
+
+bool JobSystem::takeJob(std::deque<std::pair<Job, TaskGroup *>> &queue, bool fromBack, const TaskGroup *group,
+                        std::pair<Job, TaskGroup *> &job) {
+    if (queue.empty())
+        return false;
+
+    if (group == nullptr) {
+        if (fromBack) {
+            job = std::move(queue.back());
+            queue.pop_back();
+        } else {
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        return true;
+    }
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        auto found = fromBack ? queue.end() - 1 - static_cast<std::ptrdiff_t>(i)
+                              : queue.begin() + static_cast<std::ptrdiff_t>(i);
+        if (found->second == group) {
+            job = std::move(*found);
+            queue.erase(found);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::tryRunJob(const TaskGroup *group) {
+    std::pair<Job, TaskGroup *> job;
+    bool found = false;
+    const auto numWorkers = getNumWorkers();
+    if (numWorkers == 0)
+        return false;
+
+    const bool isWorker = tJobSystem == this;
+    if (isWorker) {
+        auto &own = *mWorkers[tWorkerIndex];
+        std::lock_guard<std::mutex> lock(own.mMutex);
+        found = takeJob(own.mJobs, true, group, job);
+    }
+
+    // Steal the oldest job from the first other queue that has one
+    const unsigned start = isWorker ? tWorkerIndex + 1 : mNextQueue.load();
+    for (unsigned i = 0; i < numWorkers && !found; ++i) {
+        auto index = (start + i) % numWorkers;
+        if (isWorker && index == tWorkerIndex)
+            continue;
+
+        auto &victim = *mWorkers[index];
+        std::lock_guard<std::mutex> lock(victim.mMutex);
+        found = takeJob(victim.mJobs, false, group, job);
+    }
+
+    if (!found)
+        return false;
+
+    --mQueuedJobs;
+    job.first();
+    job.second->mPending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::work(unsigned index) {
+    tJobSystem = this;
+    tWorkerIndex = index;
+    Profiler::getInstance().setThreadName("Worker " + std::to_string(index));
+
+    for (;;) {
+        if (tryRunJob())
+            continue;
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mJobQueued.wait(lock, [this] { return mStopping || mQueuedJobs > 0; });
+        if (mStopping)
+            return;
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &body) {
+    grainSize = std::max<size_t>(grainSize, 1);
+    if (mWorkers.empty() || count <= grainSize) {
+        if (count > 0)
+            body(0, count);
+        return;
+    }
+
+    // Queue every range but the first, which this thread runs before helping with the rest
+    TaskGroup group(*this);
+    for (size_t begin = grainSize; begin < count; begin += grainSize) {
+        auto end = std::min(begin + grainSize, count);
+        group.run([&body, begin, end] { body(begin, end); });
+    }
+    body(0, grainSize);
+    group.wait();
+}
+
+void JobSystem::parallelFor(size_t count, const std::function<void(size_t)> &body) {
+    // A few ranges per thread, so that threads that finish early can steal the remainder
+    auto numRanges = 4 * (static_cast<size_t>(getNumWorkers()) + 1);
+    parallelFor(count, (count + numRanges - 1) / numRanges, [&body](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            body(i);
+    });
+}
+
+void TaskGroup::run(JobSystem::Job job) {
+    if (mJobSystem.getNumWorkers() == 0) {
+        job();
+        return;
+    }
+    mJobSystem.submit(std::move(job), *this);
+}
+
+void TaskGroup::wait() {
+    // Only help with this group's jobs, so that a thread waiting on a little work is not held up by a big unrelated job
+    while (mPending.load(std::memory_order_acquire) > 0) {
+        if (!mJobSystem.tryRunJob(this))
+            std::this_thread::yield();
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGroup;
+/// Small work-stealing job scheduler. Each worker thread has its own queue of jobs, taking the newest job from its own
+/// queue and stealing the oldest job from another queue when its own is empty. Threads waiting on a TaskGroup run
+/// that group's queued jobs while they wait, so jobs may fork more jobs and wait on them, but a thread never picks up
+/// unrelated work (the render thread lighting the frame never runs a slow simulation job, and the other way round).
+/// With no workers (always the case on Emscripten) every job runs straight away on the thread that submits it
+class JobSystem {
+  public:
+    using Job = std::function<void()>;
+
+    /// Get the singleton instance, which starts with defaultNumWorkers() workers
+    static JobSystem &getInstance() {
+        static JobSystem instance(defaultNumWorkers());
+        return instance;
+    }
+
+    /// Start the given number of worker threads
+    explicit JobSystem(unsigned numWorkers);
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    void operator=(const JobSystem &) = delete;
+
+    /// Stop the workers and start numWorkers new ones. Must not be called while any jobs are queued or running
+    void setNumWorkers(unsigned numWorkers);
+    /// Get the number of worker threads, not counting threads that submit jobs
+    unsigned getNumWorkers() const { return static_cast<unsigned>(mWorkers.size()); }
+
+    /// One worker per hardware thread other than the caller's, or none if threads are not available
+    static unsigned defaultNumWorkers();
+
+    /// Call body(begin, end) on consecutive ranges covering [0, count), each of at most grainSize indices, in parallel.
+    /// Returns once every call has finished. The calls may run in any order, so must not depend on each other
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &body);
+    /// Call body(i) for every i in [0, count) in parallel, splitting the range evenly between the threads
+    void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+  private:
+    friend class TaskGroup;
+
+    struct Worker {
+        std::mutex mMutex;
+        /// Jobs with the TaskGroup they belong to. The owner pushes and pops at the back, thieves take from the front
+        std::deque<std::pair<Job, TaskGroup *>> mJobs;
+        std::thread mThread;
+    };
+
+    /// Queue job as part of group
+    void submit(Job job, TaskGroup &group);
+    /// Run one queued job on the calling thread if there is one
+    /// \param group if not null, only run a job that belongs to this group
+    /// \return whether a job was run
+    bool tryRunJob(const TaskGroup *group = nullptr);
+    /// Take the job from the given end of queue, or the one nearest that end that belongs to group if group is not null
+    /// \return whether a job was taken
+    static bool takeJob(std::deque<std::pair<Job, TaskGroup *>> &queue, bool fromBack, const TaskGroup *group,
+                        std::pair<Job, TaskGroup *> &job);
+    /// Main loop of the worker with the given index
+    void work(unsigned index);
+    void startWorkers(unsigned numWorkers);
+    void stopWorkers();
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    /// Number of jobs queued but not yet taken, so that idle workers know when to sleep
+    std::atomic<int> mQueuedJobs{0};
+    /// Queue that jobs submitted from threads other than workers go to next
+    std::atomic<unsigned> mNextQueue{0};
+
+    std::mutex mSleepMutex;
+    /// Signalled when a job is queued or the workers are stopping
+    std::condition_variable mJobQueued;
+    bool mStopping{false};
+};
+
+/// A set of jobs that can be waited on together (fork/join)
+class TaskGroup {
+  public:
+    explicit TaskGroup(JobSystem &jobSystem = JobSystem::getInstance()) : mJobSystem(jobSystem) {}
+    /// Waits for the jobs that are still running
+    ~TaskGroup() { wait(); }
+    TaskGroup(const TaskGroup &) = delete;
+    void operator=(const TaskGroup &) = delete;
+
+    /// Queue a job to run in parallel, or run it straight away if the job system has no workers
+    void run(JobSystem::Job job);
+    /// Wait for every job in the group to finish, running the group's queued jobs on this thread in the meantime
+    void wait();
+
+  private:
+    friend class JobSystem;
+
+    JobSystem &mJobSystem;
+    /// Number of jobs that have been queued but have not finished
+    std::atomic<int> mPending{0};
+};
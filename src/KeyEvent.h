@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+/// Identifies a key by the character it types, or a special key such as an arrow
+using Keycode = uint32_t;
+/// Bit set of the modifier keys held down
+using Keymod = uint16_t;
+
+// The values match SDL's, so the frontend passes keys through unchanged and recordings made before the game was
+// separated from SDL still play back
+
+const Keycode KEY_UNKNOWN = 0x00;
+const Keycode KEY_BACKSPACE = 0x08;
+const Keycode KEY_RETURN = 0x0D;
+const Keycode KEY_ESCAPE = 0x1B;
+const Keycode KEY_SPACE = 0x20;
+const Keycode KEY_MINUS = 0x2D;
+const Keycode KEY_PERIOD = 0x2E;
+const Keycode KEY_SLASH = 0x2F;
+const Keycode KEY_1 = 0x31;
+const Keycode KEY_2 = 0x32;
+const Keycode KEY_SEMICOLON = 0x3B;
+const Keycode KEY_EQUALS = 0x3D;
+const Keycode KEY_A = 0x61;
+const Keycode KEY_B = 0x62;
+const Keycode KEY_C = 0x63;
+const Keycode KEY_D = 0x64;
+const Keycode KEY_E = 0x65;
+const Keycode KEY_G = 0x67;
+const Keycode KEY_H = 0x68;
+const Keycode KEY_I = 0x69;
+const Keycode KEY_J = 0x6A;
+const Keycode KEY_K = 0x6B;
+const Keycode KEY_L = 0x6C;
+const Keycode KEY_M = 0x6D;
+const Keycode KEY_N = 0x6E;
+const Keycode KEY_U = 0x75;
+const Keycode KEY_Y = 0x79;
+const Keycode KEY_RIGHT = 0x4000004F;
+const Keycode KEY_LEFT = 0x40000050;
+const Keycode KEY_DOWN = 0x40000051;
+const Keycode KEY_UP = 0x40000052;
+
+const Keymod KEYMOD_NONE = 0x0000;
+/// Either shift key
+const Keymod KEYMOD_SHIFT = 0x0003;
+/// Either control key
+const Keymod KEYMOD_CTRL = 0x00C0;
+
+/// A key press, as handled by the screens and the player
+struct KeyEvent {
+    Keycode mKey{KEY_UNKNOWN};
+    Keymod mMod{KEYMOD_NONE};
+};
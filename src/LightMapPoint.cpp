@@ -1,5 +1,7 @@
 #include "LightMapPoint.h"
 
+LightMapPoint::LightMapPoint(Point p, int radius, Color color, std::shared_ptr<const VisibilityMask> visibility)
+    : mPoint(p), mRadius(radius), mColor(color), mVisibility(std::move(visibility)) {}
 LightMapPoint::LightMapPoint(Point p, int radius, Color color) : mPoint(p), mRadius(radius), mColor(color) {}
 LightMapPoint::LightMapPoint(Point p, int radius) : mPoint(p), mRadius(radius), mColor(Color::getColor("white")) {}
 LightMapPoint::LightMapPoint() : mPoint(Point(0, 0)), mRadius(0), mColor(Color::getColor("white")) {}
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "Color.h"
+#include "Lighting/Shadowcasting.h"
 #include "Point.h"
 
-/// Represents a light point to be rendered with a given point, light radius,
-/// and color
+#include <memory>
+
+/// Represents a light point to be rendered with a given point and light radius (both in screen cells), and color
 struct LightMapPoint {
+    LightMapPoint(Point p, int radius, Color color, std::shared_ptr<const VisibilityMask> visibility);
     LightMapPoint(Point p, int radius, Color color);
     LightMapPoint(Point p, int radius);
     LightMapPoint();
@@ -13,4 +16,6 @@ struct LightMapPoint {
     Point mPoint;
     int mRadius;
     Color mColor;
+    /// Cells that the light can reach, centered on the light. If null the light is not occluded
+    std::shared_ptr<const VisibilityMask> mVisibility;
 };
\ No newline at end of file
@@ -1,33 +1,52 @@
 #include "LightMapTexture.h"
 #include "LightMapPoint.h"
+#include "Profiler.h"
 #include "SDLManager.h"
 
 LightMapTexture::~LightMapTexture() {
     if (mNightFadeTexture != nullptr)
         SDL_DestroyTexture(mNightFadeTexture);
+    if (mGridTexture != nullptr)
+        SDL_DestroyTexture(mGridTexture);
 }
 
-LightMapTexture::LightMapTexture(SDL_Renderer *renderer) : Texture(renderer) {
+LightMapTexture::LightMapTexture(SDL_Renderer *renderer)
+    : Texture(renderer), mGrid(World::SCREEN_WIDTH, World::SCREEN_HEIGHT,
+                               static_cast<float>(CHAR_WIDTH) / static_cast<float>(CHAR_HEIGHT)) {
     loadFromFile(std::string(SDL_GetBasePath()) + "/resources/light.png");
     mNightFadeTexture =
         SDL_CreateTexture(mRenderer, getFormat(), SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
     SDL_SetTextureBlendMode(mNightFadeTexture, SDL_BLENDMODE_MOD);
     SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_ADD);
+
+    mGridTexture = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING,
+                                     World::SCREEN_WIDTH, World::SCREEN_HEIGHT);
+    SDL_SetTextureBlendMode(mGridTexture, SDL_BLENDMODE_MOD);
+    // Smooth out the light between cells when stretching the grid over the window
+    SDL_SetTextureScaleMode(mGridTexture, SDL_SCALEMODE_LINEAR);
+}
+
+void LightMapTexture::render(const std::vector<LightMapPoint> &points, uint8_t backgroundAlpha) {
+    PROFILE_ZONE("LightMapTexture::render");
+    if (mEngine == LightingEngine::CELL_GRID && mGridTexture != nullptr)
+        renderCellGrid(points, backgroundAlpha);
+    else
+        renderSprites(points, backgroundAlpha);
 }
 
-void LightMapTexture::render(std::vector<LightMapPoint> points, Uint8 backgroundAlpha) {
+void LightMapTexture::renderSprites(const std::vector<LightMapPoint> &points, uint8_t backgroundAlpha) {
     auto oldRenderTarget = SDL_GetRenderTarget(mRenderer);
     SDL_SetRenderTarget(mRenderer, mNightFadeTexture);
     SDL_SetRenderDrawColor(mRenderer, backgroundAlpha, backgroundAlpha, backgroundAlpha, 0xFF);
     SDL_RenderFillRect(mRenderer, nullptr);
 
     for (const auto &point : points) {
-        SDL_FRect rect{
-            static_cast<float>(point.mPoint.mX - point.mRadius),
-            static_cast<float>(point.mPoint.mY - point.mRadius),
-            static_cast<float>(2 * point.mRadius),
-            static_cast<float>(2 * point.mRadius),
-        };
+        // Convert from cells to pixels, centering the light in its cell
+        const float x = static_cast<float>(point.mPoint.mX * CHAR_WIDTH + CHAR_WIDTH / 2);
+        const float y = static_cast<float>(point.mPoint.mY * CHAR_HEIGHT + CHAR_HEIGHT / 2);
+        const float radius = static_cast<float>(point.mRadius * CHAR_HEIGHT);
+
+        SDL_FRect rect{x - radius, y - radius, 2 * radius, 2 * radius};
         SDL_SetTextureColorMod(mTexture, point.mColor.r, point.mColor.g, point.mColor.b);
         Texture::render(nullptr, &rect);
     }
@@ -35,3 +54,22 @@ void LightMapTexture::render(std::vector<LightMapPoint> points, Uint8 background
     SDL_SetRenderTarget(mRenderer, oldRenderTarget);
     SDL_RenderTexture(mRenderer, mNightFadeTexture, nullptr, nullptr);
 }
+
+void LightMapTexture::renderCellGrid(const std::vector<LightMapPoint> &points, uint8_t backgroundAlpha) {
+    mGrid.accumulate(points, static_cast<float>(backgroundAlpha) / 0xFF);
+
+    void *pixels = nullptr;
+    int pitch = 0;
+    if (!SDL_LockTexture(mGridTexture, nullptr, &pixels, &pitch)) {
+        SDL_Log("Could not lock light grid texture! SDL_Error: %s", SDL_GetError());
+        return;
+    }
+    mGrid.writePixels(static_cast<uint8_t *>(pixels), pitch);
+    SDL_UnlockTexture(mGridTexture);
+
+    SDL_RenderTexture(mRenderer, mGridTexture, nullptr, nullptr);
+}
+
+LightingEngine LightMapTexture::getLightingEngine() const { return mEngine; }
+
+void LightMapTexture::setLightingEngine(LightingEngine engine) { mEngine = engine; }
@@ -1,8 +1,17 @@
 #pragma once
 
+#include "Lighting/LightGrid.h"
 #include "Texture.h"
 #include <vector>
 
+/// The available ways of computing the light map
+enum class LightingEngine {
+    /// Draw one additive light sprite per light source onto an off-screen render target
+    SPRITES,
+    /// Accumulate per-cell light on the CPU and upload it as one small streaming texture
+    CELL_GRID
+};
+
 struct LightMapPoint;
 /// Represents a texture used to render the light point
 class LightMapTexture : Texture {
@@ -18,10 +27,20 @@ class LightMapTexture : Texture {
 
     /// Renderer all the points given to the screen with backgroundAlpha
     /// representing the overall day night cycle
-    /// \param points the light points on the screen
+    /// \param points the light points on the screen, in screen cell coordinates
     /// \param backgroundAlpha the alpha value of the overall background fog
-    void render(std::vector<LightMapPoint> points, Uint8 backgroundAlpha);
+    void render(const std::vector<LightMapPoint> &points, uint8_t backgroundAlpha);
+
+    LightingEngine getLightingEngine() const;
+    void setLightingEngine(LightingEngine engine);
 
   private:
+    void renderSprites(const std::vector<LightMapPoint> &points, uint8_t backgroundAlpha);
+    void renderCellGrid(const std::vector<LightMapPoint> &points, uint8_t backgroundAlpha);
+
+    LightingEngine mEngine{LightingEngine::CELL_GRID};
     SDL_Texture *mNightFadeTexture{nullptr};
-};
\ No newline at end of file
+    /// One texel per screen cell, stretched over the window when rendered
+    SDL_Texture *mGridTexture{nullptr};
+    LightGrid mGrid;
+};
@@ -0,0 +1,135 @@
+#include "LightGrid.h"
+#include "../JobSystem.h"
+#include "../LightMapPoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+uint8_t saturate(float value) {
+    float scaled = value * 255.0f + 0.5f;
+    if (scaled >= 255.0f)
+        return 0xFF;
+    return static_cast<uint8_t>(scaled);
+}
+} // namespace
+
+LightGrid::LightGrid(int width, int height, float cellAspect)
+    : mWidth(width), mHeight(height), mStride((width + 3) & ~3), mCellAspect(cellAspect),
+      mRed(static_cast<size_t>(mStride * height)), mGreen(static_cast<size_t>(mStride * height)),
+      mBlue(static_cast<size_t>(mStride * height)),
+      mMaskRows(static_cast<size_t>(mStride * ((height + BAND_HEIGHT - 1) / BAND_HEIGHT))) {}
+
+void LightGrid::clear(float ambient) {
+    std::fill(mRed.begin(), mRed.end(), ambient);
+    std::fill(mGreen.begin(), mGreen.end(), ambient);
+    std::fill(mBlue.begin(), mBlue.end(), ambient);
+}
+
+void LightGrid::addLight(const LightMapPoint &light) { addLight(light, 0, mHeight, mMaskRows.data()); }
+
+void LightGrid::addLight(const LightMapPoint &light, int rowBegin, int rowEnd, float *mask) {
+    if (light.mRadius <= 0)
+        return;
+
+    const auto radius = static_cast<float>(light.mRadius);
+    const float invRadiusSq = 1.0f / (radius * radius);
+    const float red = light.mColor.r / 255.0f;
+    const float green = light.mColor.g / 255.0f;
+    const float blue = light.mColor.b / 255.0f;
+    const int cx = light.mPoint.mX;
+    const int cy = light.mPoint.mY;
+
+    // Cells are narrower than they are tall, so the kernel covers more columns than rows. The column range is widened
+    // to multiples of four so the SIMD loop needs no scalar tail; the extra cells fall outside the radius and get zero
+    const int xExtent = static_cast<int>(std::ceil(radius / mCellAspect));
+    const int x0 = std::max(0, cx - xExtent) & ~3;
+    const int x1 = (std::min(mWidth, cx + xExtent + 1) + 3) & ~3;
+    const int y0 = std::max(rowBegin, cy - light.mRadius);
+    const int y1 = std::min(rowEnd, cy + light.mRadius + 1);
+
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    for (int y = y0; y < y1; ++y) {
+        const auto dy = static_cast<float>(y - cy);
+        const float dySq = dy * dy;
+        float *r = &mRed[y * mStride];
+        float *g = &mGreen[y * mStride];
+        float *b = &mBlue[y * mStride];
+
+        for (int x = x0; x < x1; ++x)
+            mask[x] = light.mVisibility == nullptr || light.mVisibility->isVisible(x - cx, y - cy) ? 1.0f : 0.0f;
+
+        int x = x0;
+#if defined(__SSE2__)
+        const __m128 lane = _mm_setr_ps(0, 1, 2, 3);
+        const __m128 aspect = _mm_set1_ps(mCellAspect);
+        const __m128 vDySq = _mm_set1_ps(dySq);
+        const __m128 vInvRadiusSq = _mm_set1_ps(invRadiusSq);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 vRed = _mm_set1_ps(red);
+        const __m128 vGreen = _mm_set1_ps(green);
+        const __m128 vBlue = _mm_set1_ps(blue);
+
+        for (; x < x1; x += 4) {
+            __m128 dx = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(x - cx)), lane), aspect);
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), vDySq);
+            __m128 t = _mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(distSq, vInvRadiusSq)), zero);
+            t = _mm_mul_ps(_mm_mul_ps(t, t), _mm_loadu_ps(mask + x));
+
+            _mm_storeu_ps(r + x, _mm_add_ps(_mm_loadu_ps(r + x), _mm_mul_ps(t, vRed)));
+            _mm_storeu_ps(g + x, _mm_add_ps(_mm_loadu_ps(g + x), _mm_mul_ps(t, vGreen)));
+            _mm_storeu_ps(b + x, _mm_add_ps(_mm_loadu_ps(b + x), _mm_mul_ps(t, vBlue)));
+        }
+#endif
+        for (; x < x1; ++x) {
+            const float dx = static_cast<float>(x - cx) * mCellAspect;
+            float t = std::max(1.0f - (dx * dx + dySq) * invRadiusSq, 0.0f);
+            t *= t * mask[x];
+
+            r[x] += t * red;
+            g[x] += t * green;
+            b[x] += t * blue;
+        }
+    }
+}
+
+void LightGrid::accumulate(const std::vector<LightMapPoint> &lights, float ambient) {
+    const auto numBands = static_cast<size_t>((mHeight + BAND_HEIGHT - 1) / BAND_HEIGHT);
+    JobSystem::getInstance().parallelFor(numBands, [this, &lights, ambient](size_t band) {
+        const int rowBegin = static_cast<int>(band) * BAND_HEIGHT;
+        const int rowEnd = std::min(mHeight, rowBegin + BAND_HEIGHT);
+        const auto begin = static_cast<size_t>(rowBegin * mStride);
+        const auto end = static_cast<size_t>(rowEnd * mStride);
+
+        std::fill(mRed.begin() + begin, mRed.begin() + end, ambient);
+        std::fill(mGreen.begin() + begin, mGreen.begin() + end, ambient);
+        std::fill(mBlue.begin() + begin, mBlue.begin() + end, ambient);
+
+        float *mask = &mMaskRows[band * mStride];
+        for (const auto &light : lights)
+            addLight(light, rowBegin, rowEnd, mask);
+    });
+}
+
+void LightGrid::writePixels(uint8_t *pixels, int pitch) const {
+    for (int y = 0; y < mHeight; ++y) {
+        uint8_t *row = pixels + y * pitch;
+        const float *r = &mRed[y * mStride];
+        const float *g = &mGreen[y * mStride];
+        const float *b = &mBlue[y * mStride];
+
+        for (int x = 0; x < mWidth; ++x) {
+            row[4 * x] = saturate(r[x]);
+            row[4 * x + 1] = saturate(g[x]);
+            row[4 * x + 2] = saturate(b[x]);
+            row[4 * x + 3] = 0xFF;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vector>
+
+struct LightMapPoint;
+/// Accumulates the light intensity and colour of every cell on the screen on the CPU.
+/// Each light adds a smooth radial falloff kernel to the grid. The channels are stored as separate float planes with
+/// rows padded to a multiple of four cells, so that the kernels can be evaluated four cells at a time with SIMD.
+/// accumulate() splits the grid into bands of rows that are lit in parallel on the JobSystem
+class LightGrid {
+  public:
+    /// Number of rows in each band that accumulate() lights as one job
+    static const int BAND_HEIGHT = 4;
+
+    /// Initialize a grid of width x height cells
+    /// \param width number of cells in each row
+    /// \param height number of rows
+    /// \param cellAspect cell width divided by cell height, so that lights are round in pixel space
+    LightGrid(int width, int height, float cellAspect);
+
+    /// Reset every cell to the ambient light level
+    /// \param ambient background light level in [0, 1]
+    void clear(float ambient);
+
+    /// Add the falloff kernel of the light to the grid. The light position and radius are in cells. If the light has a
+    /// visibility mask, cells hidden from the light receive nothing
+    void addLight(const LightMapPoint &light);
+
+    /// Clear the grid to `ambient` and then add all the given lights. Each cell sums the lights in the same order
+    /// however the bands are scheduled, so the result does not depend on the number of threads
+    void accumulate(const std::vector<LightMapPoint> &lights, float ambient);
+
+    /// Write the grid as RGBA32 pixels (one byte per channel in that order), saturating each channel
+    /// \param pixels destination of at least `height` rows
+    /// \param pitch length of each destination row in bytes
+    void writePixels(uint8_t *pixels, int pitch) const;
+
+    int getWidth() const { return mWidth; }
+    int getHeight() const { return mHeight; }
+
+  private:
+    /// Add the part of the light's kernel in rows [rowBegin, rowEnd)
+    /// \param mask scratch space of at least mStride floats
+    void addLight(const LightMapPoint &light, int rowBegin, int rowEnd, float *mask);
+
+    int mWidth;
+    int mHeight;
+    /// Row length of the channel planes, rounded up to a multiple of four
+    int mStride;
+    float mCellAspect;
+
+    std::vector<float> mRed;
+    std::vector<float> mGreen;
+    std::vector<float> mBlue;
+    /// For each band of rows, the visibility of the current row of the light being added as 0 or 1 per cell
+    std::vector<float> mMaskRows;
+};
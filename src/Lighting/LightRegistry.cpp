@@ -0,0 +1,71 @@
+#include "LightRegistry.h"
+#include "../Entity/Entity.h"
+#include "../Font.h"
+#include "../Property/Properties/LightEmittingProperty.h"
+#include "../World.h"
+
+#include <algorithm>
+
+namespace {
+const std::vector<LightEmittingProperty *> NO_LIGHTS;
+
+void eraseFrom(std::vector<LightEmittingProperty *> &lights, LightEmittingProperty *light) {
+    lights.erase(std::remove(lights.begin(), lights.end(), light), lights.end());
+}
+} // namespace
+
+void LightRegistry::add(LightEmittingProperty *light) {
+    auto worldPos = light->getParent()->getWorldPos();
+    mLightsByWorldPos[worldPos].push_back(light);
+    mWorldPosByEntity[light->getParent()] = std::make_pair(light, worldPos);
+}
+
+void LightRegistry::remove(LightEmittingProperty *light) {
+    auto it = mWorldPosByEntity.find(light->getParent());
+    if (it == mWorldPosByEntity.end() || it->second.first != light)
+        return;
+
+    eraseFrom(mLightsByWorldPos[it->second.second], light);
+    mWorldPosByEntity.erase(it);
+}
+
+void LightRegistry::onEntityChangedWorldPos(const Entity &entity) {
+    auto it = mWorldPosByEntity.find(&entity);
+    if (it == mWorldPosByEntity.end())
+        return;
+
+    auto light = it->second.first;
+    auto worldPos = entity.getWorldPos();
+    eraseFrom(mLightsByWorldPos[it->second.second], light);
+    mLightsByWorldPos[worldPos].push_back(light);
+    it->second.second = worldPos;
+}
+
+const std::vector<LightEmittingProperty *> &LightRegistry::getLightsAtWorldPos(const Point &worldPos) const {
+    auto it = mLightsByWorldPos.find(worldPos);
+    if (it == mLightsByWorldPos.end())
+        return NO_LIGHTS;
+    return it->second;
+}
+
+bool LightRegistry::isLit(const Point &pos) const {
+    const Point worldPos(pos.mX / World::SCREEN_WIDTH, pos.mY / World::SCREEN_HEIGHT);
+    const float aspect = static_cast<float>(CHAR_WIDTH) / CHAR_HEIGHT;
+
+    // A light can reach onto the neighbouring screens
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            for (const auto light : getLightsAtWorldPos(worldPos + Point(x, y))) {
+                if (!light->isEnabled())
+                    continue;
+                auto diff = pos - light->getParent()->getPos();
+                auto dx = static_cast<float>(diff.mX) * aspect;
+                auto dy = static_cast<float>(diff.mY);
+                auto radius = static_cast<float>(light->getRadius());
+                if (dx * dx + dy * dy < radius * radius)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
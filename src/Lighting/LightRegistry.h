@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../Point.h"
+
+#include <unordered_map>
+#include <vector>
+
+struct Entity;
+class LightEmittingProperty;
+/// Singleton index of every light emitter, bucketed by the world position (screen) that its entity is on.
+/// LightEmittingProperty registers itself on construction and unregisters on destruction, and entities notify the
+/// registry when they move to a different screen, so finding the lights on a screen does not need to scan entities
+class LightRegistry {
+  public:
+    /// Get the singleton instance
+    static LightRegistry &getInstance() {
+        static LightRegistry instance;
+        return instance;
+    }
+
+    LightRegistry() = default;
+    // Singleton, so delete copy constructor and copy assignment operator
+    LightRegistry(const LightRegistry &) = delete;
+    void operator=(const LightRegistry &) = delete;
+
+    /// Register light under the current world position of its parent entity
+    void add(LightEmittingProperty *light);
+    /// Unregister light, does nothing if it was not registered
+    void remove(LightEmittingProperty *light);
+    /// Should be called when entity moves to a different world position, moving its light (if it has one) to the
+    /// bucket of the new world position
+    void onEntityChangedWorldPos(const Entity &entity);
+
+    /// Get all the lights registered on the screen at worldPos, enabled or not
+    /// \param worldPos position in world space
+    /// \return lights on that screen
+    const std::vector<LightEmittingProperty *> &getLightsAtWorldPos(const Point &worldPos) const;
+
+    /// Does any enabled light reach the world space point pos?
+    /// Uses the same shape as the light map kernel, ignoring occlusion
+    /// \param pos point in world space
+    bool isLit(const Point &pos) const;
+
+  private:
+    /// Lights keyed by the world position they were registered under
+    std::unordered_map<Point, std::vector<LightEmittingProperty *>> mLightsByWorldPos;
+    /// The world position that each light was registered under, keyed by its parent entity
+    std::unordered_map<const Entity *, std::pair<LightEmittingProperty *, Point>> mWorldPosByEntity;
+};
@@ -0,0 +1,47 @@
+#include "LightVisibilityCache.h"
+#include "../OccupancyGrid.h"
+
+std::shared_ptr<const VisibilityMask> LightVisibilityCache::get(const std::string &ID, Point pos, int radius,
+                                                                const OccupancyGrid &grid) {
+    auto &entry = mEntries[ID];
+    entry.mUsed = true;
+
+    if (entry.mMask != nullptr && entry.mMask->mOrigin == pos && entry.mMask->mRadius == radius) {
+        if (entry.mRevision == grid.getRevision())
+            return entry.mMask;
+
+        // The grid changed somewhere, but only recompute if it changed inside this light's radius
+        snapshotOpacity(grid, pos, radius, mScratch);
+        if (mScratch == entry.mOpacity) {
+            entry.mRevision = grid.getRevision();
+            return entry.mMask;
+        }
+    }
+
+    auto mask = std::make_shared<VisibilityMask>();
+    computeVisibility(grid, pos, radius, *mask);
+    entry.mMask = std::move(mask);
+    entry.mRevision = grid.getRevision();
+    snapshotOpacity(grid, pos, radius, entry.mOpacity);
+
+    return entry.mMask;
+}
+
+void LightVisibilityCache::prune() {
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        if (!it->second.mUsed) {
+            it = mEntries.erase(it);
+        } else {
+            it->second.mUsed = false;
+            ++it;
+        }
+    }
+}
+
+void LightVisibilityCache::snapshotOpacity(const OccupancyGrid &grid, Point origin, int radius,
+                                           std::vector<uint8_t> &opacity) {
+    opacity.clear();
+    for (int dy = -radius; dy <= radius; ++dy)
+        for (int dx = -radius; dx <= radius; ++dx)
+            opacity.push_back(static_cast<uint8_t>(grid.isOpaque(origin + Point(dx, dy))));
+}
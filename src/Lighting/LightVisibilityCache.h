@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Shadowcasting.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/// Caches the shadowcast visibility of each light source, keyed by the ID of the emitting entity.
+/// A light's visibility is only recomputed when it moves, its radius changes, or the occupancy grid changes inside its
+/// radius, so static lights pay for shadowcasting once rather than every frame
+class LightVisibilityCache {
+  public:
+    /// Get the visibility of the light emitted by entity ID at pos with the given radius, recomputing it if needed.
+    /// The returned mask is never modified afterwards, a recomputation produces a new mask
+    std::shared_ptr<const VisibilityMask> get(const std::string &ID, Point pos, int radius,
+                                              const OccupancyGrid &grid);
+
+    /// Forget lights that have not been requested since the last call to prune
+    void prune();
+
+  private:
+    struct Entry {
+        std::shared_ptr<const VisibilityMask> mMask;
+        /// Revision of the occupancy grid the mask was last validated against
+        uint32_t mRevision{0};
+        /// Opacity of the cells inside the mask when it was computed
+        std::vector<uint8_t> mOpacity;
+        bool mUsed{true};
+    };
+
+    /// Copy the opacity of the cells covered by a mask with the given origin and radius into opacity
+    static void snapshotOpacity(const OccupancyGrid &grid, Point origin, int radius, std::vector<uint8_t> &opacity);
+
+    std::unordered_map<std::string, Entry> mEntries;
+    /// Scratch buffer used to compare opacity without allocating
+    std::vector<uint8_t> mScratch;
+};
@@ -0,0 +1,74 @@
+#include "Shadowcasting.h"
+#include "../OccupancyGrid.h"
+
+void VisibilityMask::reset(Point origin, int radius) {
+    mOrigin = origin;
+    mRadius = radius;
+    mCells.assign(static_cast<size_t>((2 * radius + 1) * (2 * radius + 1)), 0);
+}
+
+namespace {
+// Transforms from octant-local (column, row) coordinates to world offsets for each of the eight octants
+const int OCTANTS[8][4] = {
+    {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+    {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1},
+};
+
+// Scan the rows of one octant between the slopes start and end, recursing past each run of blocking cells.
+// See http://www.roguebasin.com/index.php/FOV_using_recursive_shadowcasting
+void castLight(const OccupancyGrid &grid, VisibilityMask &mask, int row, float start, float end, const int *octant) {
+    if (start < end)
+        return;
+
+    const Point origin = mask.mOrigin;
+    const int radius = mask.mRadius;
+    const int radiusSq = radius * radius;
+    float newStart = 0;
+
+    for (int j = row; j <= radius; ++j) {
+        bool blocked = false;
+        const int dy = -j;
+
+        for (int dx = -j; dx <= 0; ++dx) {
+            const float leftSlope = (static_cast<float>(dx) - 0.5f) / (static_cast<float>(dy) + 0.5f);
+            const float rightSlope = (static_cast<float>(dx) + 0.5f) / (static_cast<float>(dy) - 0.5f);
+
+            if (start < rightSlope)
+                continue;
+            if (end > leftSlope)
+                break;
+
+            const int offsetX = dx * octant[0] + dy * octant[1];
+            const int offsetY = dx * octant[2] + dy * octant[3];
+
+            if (dx * dx + dy * dy <= radiusSq)
+                mask.setVisible(offsetX, offsetY);
+
+            const bool opaque = grid.isOpaque(origin + Point(offsetX, offsetY));
+            if (blocked) {
+                if (opaque) {
+                    newStart = rightSlope;
+                } else {
+                    blocked = false;
+                    start = newStart;
+                }
+            } else if (opaque && j < radius) {
+                blocked = true;
+                castLight(grid, mask, j + 1, start, leftSlope, octant);
+                newStart = rightSlope;
+            }
+        }
+
+        if (blocked)
+            break;
+    }
+}
+} // namespace
+
+void computeVisibility(const OccupancyGrid &grid, Point origin, int radius, VisibilityMask &mask) {
+    mask.reset(origin, radius);
+    mask.setVisible(0, 0);
+
+    for (const auto &octant : OCTANTS)
+        castLight(grid, mask, 1, 1.0f, 0.0f, octant);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../Point.h"
+
+#include <cstdint>
+#include <vector>
+
+class OccupancyGrid;
+/// The set of cells visible from an origin, stored as a square of offsets [-radius, radius] around the origin
+struct VisibilityMask {
+    /// World position the mask was computed from
+    Point mOrigin;
+    int mRadius{0};
+    /// One byte per cell, row-major, (2 * mRadius + 1) cells per row
+    std::vector<uint8_t> mCells;
+
+    /// Resize to the given radius and mark every cell as not visible
+    void reset(Point origin, int radius);
+
+    /// Is the cell at offset (dx, dy) from the origin visible? Offsets outside the mask are not visible
+    bool isVisible(int dx, int dy) const {
+        if (dx < -mRadius || dx > mRadius || dy < -mRadius || dy > mRadius)
+            return false;
+        return mCells[(dy + mRadius) * (2 * mRadius + 1) + (dx + mRadius)] != 0;
+    }
+
+    void setVisible(int dx, int dy) { mCells[(dy + mRadius) * (2 * mRadius + 1) + (dx + mRadius)] = 1; }
+};
+
+/// Compute the cells visible from origin within a circle of the given radius using recursive shadowcasting, treating
+/// cells marked OCCUPANCY_OPAQUE in grid as blockers. Blocking cells are themselves visible, so walls get lit.
+/// \param grid occupancy of the world around origin, cells outside it are transparent
+/// \param origin world position to cast from
+/// \param radius maximum distance in cells
+/// \param mask output visibility, reset to cover the radius around origin
+void computeVisibility(const OccupancyGrid &grid, Point origin, int radius, VisibilityMask &mask);
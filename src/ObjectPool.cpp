@@ -0,0 +1,85 @@
+#include "ObjectPool.h"
+
+#include <algorithm>
+
+namespace {
+/// Guards the list of pools
+std::mutex &getPoolsMutex() {
+    static auto *mutex = new std::mutex;
+    return *mutex;
+}
+
+/// Every pool that has been created. Never destroyed, like the pools themselves
+std::vector<const ObjectPool *> &getPoolList() {
+    static auto *pools = new std::vector<const ObjectPool *>;
+    return *pools;
+}
+} // namespace
+
+const size_t ObjectPool::OBJECTS_PER_CHUNK;
+
+ObjectPool::ObjectPool(const char *name, size_t objectSize, size_t alignment) : mName(name), mObjectSize(objectSize) {
+    mSlotSize = std::max(objectSize, sizeof(FreeSlot));
+    alignment = std::max(alignment, alignof(FreeSlot));
+    mSlotSize = (mSlotSize + alignment - 1) / alignment * alignment;
+
+    std::lock_guard<std::mutex> lock(getPoolsMutex());
+    getPoolList().push_back(this);
+}
+
+void *ObjectPool::allocate(size_t size) {
+    if (size > mObjectSize)
+        return ::operator new(size);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mFreeList == nullptr)
+        addChunk();
+    auto slot = mFreeList;
+    mFreeList = slot->mNext;
+    ++mLiveCount;
+    return slot;
+}
+
+void ObjectPool::deallocate(void *pointer, size_t size) {
+    if (pointer == nullptr)
+        return;
+    if (size > mObjectSize) {
+        ::operator delete(pointer);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto slot = static_cast<FreeSlot *>(pointer);
+    slot->mNext = mFreeList;
+    mFreeList = slot;
+    --mLiveCount;
+}
+
+void ObjectPool::addChunk() {
+    // new char[] is aligned for any type no more aligned than std::max_align_t, and slots are a multiple of the
+    // alignment apart
+    mChunks.emplace_back(new char[mSlotSize * OBJECTS_PER_CHUNK]);
+    auto chunk = mChunks.back().get();
+
+    // Thread the slots onto the free list back to front, so they are handed out in address order
+    for (size_t i = OBJECTS_PER_CHUNK; i-- > 0;) {
+        auto slot = reinterpret_cast<FreeSlot *>(chunk + i * mSlotSize);
+        slot->mNext = mFreeList;
+        mFreeList = slot;
+    }
+}
+
+size_t ObjectPool::getLiveCount() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLiveCount;
+}
+
+size_t ObjectPool::getCapacity() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mChunks.size() * OBJECTS_PER_CHUNK;
+}
+
+std::vector<const ObjectPool *> ObjectPool::getPools() {
+    std::lock_guard<std::mutex> lock(getPoolsMutex());
+    return getPoolList();
+}
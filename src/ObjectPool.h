@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// Free list of equally sized slots for the objects of one type, carved out of chunks of OBJECTS_PER_CHUNK slots, so
+/// that objects of the same kind are packed together and creating and destroying them only pushes and pops the list.
+/// Chunks are never given back, so a pool stays as big as the most objects that were alive at once. Safe to use from
+/// any thread, as behaviours may be added while entities plan in parallel
+class ObjectPool {
+  public:
+    /// Number of slots in each chunk
+    static const size_t OBJECTS_PER_CHUNK = 64;
+
+    /// \param name name of the type, for reports
+    /// \param objectSize size of the type
+    /// \param alignment alignment of the type, at most that of std::max_align_t
+    ObjectPool(const char *name, size_t objectSize, size_t alignment);
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    /// Get a slot for an object of size bytes. Subclasses of the pooled type that are bigger than it are allocated with
+    /// the global operator new instead
+    void *allocate(size_t size);
+    /// Give back the slot of an object of size bytes, which must have come from allocate() with the same size
+    void deallocate(void *pointer, size_t size);
+
+    const char *getName() const { return mName; }
+    /// Number of slots handed out and not yet given back
+    size_t getLiveCount() const;
+    /// Number of slots in all chunks
+    size_t getCapacity() const;
+
+    /// Get every pool that has been created
+    static std::vector<const ObjectPool *> getPools();
+
+  private:
+    /// An unused slot, which holds the next unused slot
+    struct FreeSlot {
+        FreeSlot *mNext;
+    };
+
+    /// Carve a new chunk into free slots. mMutex must be held
+    void addChunk();
+
+    const char *mName;
+    size_t mObjectSize;
+    /// Distance between slots, the object size rounded up to the alignment and big enough for a FreeSlot
+    size_t mSlotSize;
+
+    /// Guards everything below
+    mutable std::mutex mMutex;
+    std::vector<std::unique_ptr<char[]>> mChunks;
+    FreeSlot *mFreeList{nullptr};
+    size_t mLiveCount{0};
+};
+
+/// Get the pool for objects of type T. Pools are never destroyed, so objects that outlive main(), such as the entities
+/// held by singletons, can still be deleted
+template <typename T> ObjectPool &getObjectPool(const char *name) {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Pool chunks are only aligned for std::max_align_t");
+    static auto *pool = new ObjectPool(name, sizeof(T), alignof(T));
+    return *pool;
+}
+
+// Goes in the public part of the class body of a type that is created and destroyed often, such as an Entity,
+// Behaviour or Property subclass, so that new and std::make_unique take its objects from the type's own pool.
+// Subclasses without the macro are bigger than the type, so fall back to the global operator new
+#define POOLED_ALLOCATION(Type) POOLED_ALLOCATION_FROM(Type, #Type)
+
+// Like POOLED_ALLOCATION, but takes the objects from the pool of PoolType, reported as name. Used by class templates,
+// whose instantiations would otherwise each get a pool with the same name, so that they share one pool instead
+#define POOLED_ALLOCATION_FROM(PoolType, name)                                                                         \
+    static void *operator new(std::size_t size) { return getObjectPool<PoolType>(name).allocate(size); }              \
+    static void operator delete(void *pointer, std::size_t size) {                                                     \
+        getObjectPool<PoolType>(name).deallocate(pointer, size);                                                       \
+    }
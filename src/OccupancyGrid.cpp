@@ -0,0 +1,26 @@
+#include "OccupancyGrid.h"
+
+#include <algorithm>
+
+void OccupancyGrid::reset(Point origin, int width, int height) {
+    mOrigin = origin;
+    mWidth = width;
+    mHeight = height;
+    mCells.assign(static_cast<size_t>(width * height), OCCUPANCY_NONE);
+}
+
+void OccupancyGrid::mark(const Point &pos, uint8_t flags) {
+    if (contains(pos))
+        mCells[(pos.mY - mOrigin.mY) * mWidth + (pos.mX - mOrigin.mX)] |= flags;
+}
+
+void OccupancyGrid::assign(const OccupancyGrid &other) {
+    if (mOrigin == other.mOrigin && mWidth == other.mWidth && mHeight == other.mHeight && mCells == other.mCells)
+        return;
+
+    mOrigin = other.mOrigin;
+    mWidth = other.mWidth;
+    mHeight = other.mHeight;
+    mCells = other.mCells;
+    ++mRevision;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstdint>
+#include <vector>
+
+/// Bit flags describing what an occupied cell blocks
+enum OCCUPANCY_FLAG : uint8_t {
+    OCCUPANCY_NONE = 0,
+    /// Blocks light and sight
+    OCCUPANCY_OPAQUE = 1,
+    /// Cannot be walked through
+    OCCUPANCY_SOLID = 2
+};
+
+/// A rectangular window of the world recording which cells are opaque or solid.
+/// The revision number only changes when the contents of the grid change, so that anything derived from the grid can
+/// be cached against it
+class OccupancyGrid {
+  public:
+    /// Clear the grid and move it to cover width x height cells with top-left corner at origin (world coordinates)
+    void reset(Point origin, int width, int height);
+
+    /// Add flags to the cell at the world position pos, ignoring positions outside the grid
+    void mark(const Point &pos, uint8_t flags);
+
+    /// Get the flags of the cell at the world position pos, cells outside the grid are empty
+    uint8_t get(const Point &pos) const {
+        if (!contains(pos))
+            return OCCUPANCY_NONE;
+        return mCells[(pos.mY - mOrigin.mY) * mWidth + (pos.mX - mOrigin.mX)];
+    }
+
+    bool isOpaque(const Point &pos) const { return (get(pos) & OCCUPANCY_OPAQUE) != 0; }
+    bool isSolid(const Point &pos) const { return (get(pos) & OCCUPANCY_SOLID) != 0; }
+
+    /// Is the world position pos inside the grid?
+    bool contains(const Point &pos) const {
+        return pos.mX >= mOrigin.mX && pos.mX < mOrigin.mX + mWidth && pos.mY >= mOrigin.mY &&
+               pos.mY < mOrigin.mY + mHeight;
+    }
+
+    /// Replace the contents of this grid with other, only bumping the revision if anything changed
+    void assign(const OccupancyGrid &other);
+
+    const Point &getOrigin() const { return mOrigin; }
+    int getWidth() const { return mWidth; }
+    int getHeight() const { return mHeight; }
+    uint32_t getRevision() const { return mRevision; }
+
+  private:
+    Point mOrigin;
+    int mWidth{0};
+    int mHeight{0};
+    uint32_t mRevision{0};
+    std::vector<uint8_t> mCells;
+};
@@ -0,0 +1,148 @@
+#include "Pathfinder.h"
+#include "OccupancyGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+
+namespace {
+const Point STEPS[] = {Point(1, 0),  Point(-1, 0), Point(0, 1),   Point(0, -1),
+                       Point(1, 1), Point(-1, 1), Point(1, -1), Point(-1, -1)};
+
+/// Number of steps between a and b ignoring obstacles, as diagonal steps cost the same as orthogonal ones
+int heuristic(const Point &a, const Point &b) { return std::max(std::abs(a.mX - b.mX), std::abs(a.mY - b.mY)); }
+} // namespace
+
+bool Pathfinder::findPath(const OccupancyGrid &grid, const Point &from, const Point &goal, std::vector<Point> &path) {
+    path.clear();
+    if (!grid.contains(from) || !grid.contains(goal))
+        return false;
+
+    const Point origin = grid.getOrigin();
+    const int width = grid.getWidth();
+    const auto numCells = static_cast<size_t>(width * grid.getHeight());
+    auto index = [&](const Point &p) { return (p.mY - origin.mY) * width + (p.mX - origin.mX); };
+    auto point = [&](int i) { return Point(origin.mX + i % width, origin.mY + i / width); };
+
+    if (mVisited.size() != numCells) {
+        mCost.assign(numCells, 0);
+        mCameFrom.assign(numCells, -1);
+        mVisited.assign(numCells, 0);
+        mSearch = 0;
+    }
+    // Starting a new search invalidates every cell without clearing the arrays
+    ++mSearch;
+
+    // Entries are (estimated total cost, cell index)
+    using Node = std::pair<int, int>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> open;
+
+    const int start = index(from);
+    const int end = index(goal);
+    mVisited[start] = mSearch;
+    mCost[start] = 0;
+    mCameFrom[start] = -1;
+    open.emplace(heuristic(from, goal), start);
+
+    while (!open.empty()) {
+        const Node node = open.top();
+        open.pop();
+        const int current = node.second;
+        const Point currentPos = point(current);
+
+        // Skip stale entries left behind when a cheaper route to the cell was found
+        if (node.first - heuristic(currentPos, goal) > mCost[current])
+            continue;
+
+        if (current == end) {
+            for (int i = end; i != -1; i = mCameFrom[i])
+                path.push_back(point(i));
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        for (const auto &step : STEPS) {
+            const Point nextPos = currentPos + step;
+            if (!grid.contains(nextPos))
+                continue;
+            const int next = index(nextPos);
+            if (next != end && grid.isSolid(nextPos))
+                continue;
+
+            const int cost = mCost[current] + 1;
+            if (mVisited[next] == mSearch && mCost[next] <= cost)
+                continue;
+
+            mVisited[next] = mSearch;
+            mCost[next] = cost;
+            mCameFrom[next] = current;
+            open.emplace(cost + heuristic(nextPos, goal), next);
+        }
+    }
+
+    return false;
+}
+
+Point Pathfinder::getNextStep(const std::string &requesterID, const Point &from, const Point &goal,
+                              const OccupancyGrid &grid) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &path = mPaths[requesterID];
+    path.mUsed = true;
+
+    // Only search again for a goal that couldn't be reached if the grid has changed
+    bool needsSearch =
+        !path.mSearched || path.mGoal != goal || (!path.mFound && path.mRevision != grid.getRevision());
+
+    if (!needsSearch && path.mFound) {
+        // Follow the path if the entity took the last step, or wait if it didn't manage to. Otherwise it has been
+        // moved off the path and needs a new one
+        if (path.mCurrent + 1 < path.mSteps.size() && path.mSteps[path.mCurrent + 1] == from)
+            ++path.mCurrent;
+        else if (path.mSteps[path.mCurrent] != from)
+            needsSearch = true;
+
+        // The grid changed, but the path can be kept if nothing along the rest of it became solid
+        if (!needsSearch && path.mRevision != grid.getRevision()) {
+            if (isStillWalkable(path, grid))
+                path.mRevision = grid.getRevision();
+            else
+                needsSearch = true;
+        }
+    }
+
+    if (needsSearch) {
+        path.mSearched = true;
+        path.mGoal = goal;
+        path.mFound = findPath(grid, from, goal, path.mSteps);
+        path.mCurrent = 0;
+        path.mRevision = grid.getRevision();
+    }
+
+    if (!path.mFound)
+        return from.stepTowards(goal);
+    if (path.mCurrent + 1 < path.mSteps.size())
+        return path.mSteps[path.mCurrent + 1];
+    return from;
+}
+
+void Pathfinder::prune() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mPaths.begin(); it != mPaths.end();) {
+        if (!it->second.mUsed) {
+            it = mPaths.erase(it);
+        } else {
+            it->second.mUsed = false;
+            ++it;
+        }
+    }
+}
+
+bool Pathfinder::isStillWalkable(const CachedPath &path, const OccupancyGrid &grid) {
+    // The goal may be solid, so only check up to the step before it
+    for (size_t i = path.mCurrent + 1; i + 1 < path.mSteps.size(); ++i) {
+        if (grid.isSolid(path.mSteps[i]))
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class OccupancyGrid;
+/// Finds shortest paths on the tile grid with A*, moving in all eight directions and not passing through solid cells.
+/// Paths are cached per requesting entity and followed step by step. When the occupancy grid changes, the rest of a
+/// cached path is checked for newly solid cells rather than searched for again
+class Pathfinder {
+  public:
+    /// Find a shortest path from `from` to goal within grid. The goal itself may be solid, e.g. a home that is entered
+    /// \param path filled with the positions from `from` to goal inclusive, or cleared if there is no path
+    /// \return whether a path was found
+    bool findPath(const OccupancyGrid &grid, const Point &from, const Point &goal, std::vector<Point> &path);
+
+    /// Get the position that the entity with ID requesterID, currently at `from`, should move to next on its way to
+    /// goal. Reuses the entity's cached path where possible. If there is no path then steps straight towards goal. Safe
+    /// to call from several threads at once, and the result does not depend on the order of the calls
+    Point getNextStep(const std::string &requesterID, const Point &from, const Point &goal,
+                      const OccupancyGrid &grid);
+
+    /// Forget the paths of entities that have not asked for a step since the last call to prune
+    void prune();
+
+  private:
+    struct CachedPath {
+        Point mGoal;
+        /// Positions from the start of the path to the goal inclusive
+        std::vector<Point> mSteps;
+        /// Index into mSteps of where the entity should currently be
+        size_t mCurrent{0};
+        /// Whether a path has been searched for yet
+        bool mSearched{false};
+        /// Whether a path exists, if not then mSteps is empty
+        bool mFound{false};
+        /// Revision of the occupancy grid the path was last checked against
+        uint32_t mRevision{0};
+        bool mUsed{true};
+    };
+
+    /// Is every step of path after its current position still walkable in grid?
+    static bool isStillWalkable(const CachedPath &path, const OccupancyGrid &grid);
+
+    /// Guards the cached paths and the search scratch space
+    std::mutex mMutex;
+    std::unordered_map<std::string, CachedPath> mPaths;
+
+    // Search scratch space, one entry per grid cell, kept between searches to avoid allocating
+    std::vector<int> mCost;
+    std::vector<int> mCameFrom;
+    /// mCost and mCameFrom entries are only valid if the cell's entry here equals mSearch
+    std::vector<uint32_t> mVisited;
+    uint32_t mSearch{0};
+};
@@ -0,0 +1,86 @@
+#include "PerformanceStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__unix__)
+#include <unistd.h>
+#endif
+
+const size_t PerformanceStats::NUM_FRAMES;
+
+void PerformanceStats::addTime(FramePhase phase, double seconds) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCurrent[static_cast<size_t>(phase)] += seconds;
+}
+
+void PerformanceStats::endFrame(double frameSeconds) {
+    auto allocations = getAllocationCounts();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCurrent[static_cast<size_t>(FramePhase::FRAME)] = frameSeconds;
+    for (size_t phase = 0; phase < NUM_FRAME_PHASES; ++phase) {
+        mHistory[phase][mNumFrames % NUM_FRAMES] = mCurrent[phase];
+        mCurrent[phase] = 0;
+    }
+    ++mNumFrames;
+
+    mFrameAllocations.mAllocations = allocations.mAllocations - mFrameStartAllocations.mAllocations;
+    mFrameAllocations.mBytes = allocations.mBytes - mFrameStartAllocations.mBytes;
+    mFrameStartAllocations = allocations;
+}
+
+PerformanceStats::PhaseSummary PerformanceStats::getSummary(FramePhase phase) const {
+    PhaseSummary summary;
+    std::vector<double> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mNumFrames == 0)
+            return summary;
+        const auto &history = mHistory[static_cast<size_t>(phase)];
+        summary.mLast = 1000.0 * history[(mNumFrames - 1) % NUM_FRAMES];
+        sorted.assign(history.cbegin(), history.cbegin() + std::min(mNumFrames, NUM_FRAMES));
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        auto index = static_cast<size_t>(p * static_cast<double>(sorted.size()));
+        return 1000.0 * sorted[std::min(sorted.size() - 1, index)];
+    };
+    summary.mP50 = percentile(0.5);
+    summary.mP95 = percentile(0.95);
+    summary.mP99 = percentile(0.99);
+    return summary;
+}
+
+AllocationCounts PerformanceStats::getFrameAllocations() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mFrameAllocations;
+}
+
+size_t PerformanceStats::getResidentMemory() {
+#if defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return 0;
+    return static_cast<size_t>(info.resident_size);
+#elif defined(__unix__)
+    // The second field of statm is the number of resident pages
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (statm == nullptr)
+        return 0;
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    const int numRead = std::fscanf(statm, "%lu %lu", &size, &resident);
+    std::fclose(statm);
+    if (numRead != 2)
+        return 0;
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
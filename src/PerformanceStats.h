@@ -0,0 +1,110 @@
+#pragma once
+
+#include "AllocationCounter.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+/// The parts of a frame that are timed, on either thread
+enum class FramePhase {
+    /// Handling input and ticking the world, on the simulation thread
+    SIMULATE,
+    /// Field of view and recording the floor
+    WORLD_RENDER,
+    /// Recording the entities
+    ENTITY_RENDER,
+    /// Drawing the light map, on the render thread
+    LIGHTING,
+    /// Recording the status bar, notifications, screens and message boxes
+    UI,
+    /// Drawing the recorded glyphs and presenting the frame, on the render thread
+    PRESENT,
+    /// The whole frame on the render thread, not counting the sleep to cap the frame rate
+    FRAME
+};
+const size_t NUM_FRAME_PHASES = 7;
+
+/// Rolling statistics of the latest frames, shown by the performance overlay
+class PerformanceStats {
+  public:
+    /// Number of frames the percentiles are taken over
+    static const size_t NUM_FRAMES = 120;
+
+    /// Milliseconds spent in a phase per frame
+    struct PhaseSummary {
+        double mLast{0};
+        double mP50{0};
+        double mP95{0};
+        double mP99{0};
+    };
+
+    /// Get the singleton instance
+    static PerformanceStats &getInstance() {
+        static PerformanceStats instance;
+        return instance;
+    }
+
+    PerformanceStats(const PerformanceStats &) = delete;
+    void operator=(const PerformanceStats &) = delete;
+
+    /// Add time spent in phase to the current frame. Safe to call from any thread
+    void addTime(FramePhase phase, double seconds);
+    /// Finish the current frame, called once per frame by the render thread
+    /// \param frameSeconds time the frame took, not counting the sleep to cap the frame rate
+    void endFrame(double frameSeconds);
+
+    /// Get the latest time and percentiles of phase over the last NUM_FRAMES frames
+    PhaseSummary getSummary(FramePhase phase) const;
+    /// Get the allocations made during the last frame, by every thread
+    AllocationCounts getFrameAllocations() const;
+
+    /// Is the performance overlay shown? It is only worth keeping statistics while it is
+    bool isOverlayEnabled() const { return mOverlayEnabled.load(std::memory_order_relaxed); }
+    void setOverlayEnabled(bool enabled) { mOverlayEnabled.store(enabled, std::memory_order_relaxed); }
+
+    /// Get the resident set size of the process in bytes, or 0 if it cannot be found on this platform
+    static size_t getResidentMemory();
+
+  private:
+    PerformanceStats() = default;
+
+    std::atomic<bool> mOverlayEnabled{false};
+
+    /// Guards everything below, as phases are timed on both threads
+    mutable std::mutex mMutex;
+    /// Time spent in each phase so far this frame
+    std::array<double, NUM_FRAME_PHASES> mCurrent{};
+    /// Seconds spent in each phase in the latest frames, the latest at (mNumFrames - 1) % NUM_FRAMES
+    std::array<std::array<double, NUM_FRAMES>, NUM_FRAME_PHASES> mHistory{};
+    size_t mNumFrames{0};
+    AllocationCounts mFrameStartAllocations{};
+    AllocationCounts mFrameAllocations{};
+};
+
+/// Adds the time spent in its scope to a phase of the current frame, if the performance overlay is shown
+class PhaseTimer {
+  public:
+    explicit PhaseTimer(FramePhase phase) : mPhase(phase) {
+        if (PerformanceStats::getInstance().isOverlayEnabled()) {
+            mTiming = true;
+            mStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PhaseTimer() {
+        if (mTiming)
+            PerformanceStats::getInstance().addTime(
+                mPhase, std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count());
+    }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+  private:
+    FramePhase mPhase;
+    bool mTiming{false};
+    std::chrono::steady_clock::time_point mStart;
+};
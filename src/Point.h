@@ -54,6 +54,11 @@ struct Point {
 
     double distanceTo(const Point& to);
 
+    /// Square of the distance to `to`, avoiding the square root when comparing distances
+    int distanceSquaredTo(const Point &to) const {
+        return (to.mX - mX) * (to.mX - mX) + (to.mY - mY) * (to.mY - mY);
+    }
+
     double length() {
         return std::sqrt(mX*mX + mY*mY);
     }
@@ -66,6 +71,20 @@ struct Point {
         return std::abs(other.mX - this->mX) + std::abs(other.mY - this->mY);
     }
 
+    /// The point one step (possibly diagonal) from this one in the direction of `to`, ignoring obstacles
+    Point stepTowards(const Point &to) const {
+        Point next = *this;
+        if (to.mX > mX)
+            next.mX++;
+        else if (to.mX < mX)
+            next.mX--;
+        if (to.mY > mY)
+            next.mY++;
+        else if (to.mY < mY)
+            next.mY--;
+        return next;
+    }
+
     Point& abs() {
         this->mX = std::abs(mX);
         this->mY = std::abs(mY);
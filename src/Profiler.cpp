@@ -0,0 +1,136 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+/// Names the current thread has already interned, so that interning usually takes no lock
+thread_local std::unordered_map<std::string, const char *> tInternedNames;
+/// Name given to the current thread before it recorded a zone
+thread_local std::string tThreadName;
+
+uint64_t steadyNanoseconds() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/// Write str as a JSON string, escaping the characters that need it
+void writeJSONString(std::ostream &out, const std::string &str) {
+    out << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out << ' ';
+        else
+            out << c;
+    }
+    out << '"';
+}
+} // namespace
+
+const size_t Profiler::EVENTS_PER_THREAD;
+thread_local Profiler::ThreadBuffer *Profiler::tThreadBuffer = nullptr;
+
+Profiler::Profiler() : mEpoch(steadyNanoseconds()) {}
+
+uint64_t Profiler::now() const { return steadyNanoseconds() - mEpoch; }
+
+Profiler::ThreadBuffer &Profiler::getThreadBuffer() {
+    if (tThreadBuffer != nullptr)
+        return *tThreadBuffer;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mBuffers.push_back(std::make_unique<ThreadBuffer>());
+    auto &buffer = *mBuffers.back();
+    buffer.mThreadID = static_cast<unsigned>(mBuffers.size());
+    buffer.mName = tThreadName.empty() ? "Thread " + std::to_string(buffer.mThreadID) : tThreadName;
+    buffer.mEvents.resize(EVENTS_PER_THREAD);
+    tThreadBuffer = &buffer;
+    return buffer;
+}
+
+void Profiler::setThreadName(const std::string &name) {
+    tThreadName = name;
+    if (tThreadBuffer != nullptr) {
+        std::lock_guard<std::mutex> lock(tThreadBuffer->mMutex);
+        tThreadBuffer->mName = name;
+    }
+}
+
+const char *Profiler::intern(const std::string &name) {
+    auto cached = tInternedNames.find(name);
+    if (cached != tInternedNames.end())
+        return cached->second;
+
+    const char *interned;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // Elements of an unordered_set never move, so the pointer stays valid
+        interned = mInternedNames.insert(name).first->c_str();
+    }
+    tInternedNames.emplace(name, interned);
+    return interned;
+}
+
+void Profiler::record(const char *name, uint64_t start, uint64_t end) {
+    auto &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mMutex);
+    buffer.mEvents[buffer.mNumRecorded % EVENTS_PER_THREAD] = {name, start, end};
+    ++buffer.mNumRecorded;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto &buffer : mBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+        buffer->mNumRecorded = 0;
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string &path) {
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separate = [&] {
+        if (!first)
+            out << ",\n";
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    char timestamps[64];
+    for (auto &buffer : mBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+
+        separate();
+        out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->mThreadID
+            << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        writeJSONString(out, buffer->mName);
+        out << "}}";
+
+        // Oldest first
+        const uint64_t numKept = std::min<uint64_t>(buffer->mNumRecorded, EVENTS_PER_THREAD);
+        for (uint64_t i = buffer->mNumRecorded - numKept; i < buffer->mNumRecorded; ++i) {
+            const auto &event = buffer->mEvents[i % EVENTS_PER_THREAD];
+            separate();
+            // Chrome traces are in microseconds
+            std::snprintf(timestamps, sizeof(timestamps), "\"ts\":%.3f,\"dur\":%.3f",
+                          static_cast<double>(event.mStart) / 1000.0,
+                          static_cast<double>(event.mEnd - event.mStart) / 1000.0);
+            out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->mThreadID << ",\"name\":";
+            writeJSONString(out, event.mName);
+            out << ',' << timestamps << '}';
+        }
+    }
+    out << "\n]}\n";
+
+    return static_cast<bool>(out);
+}
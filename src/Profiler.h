@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// One timed zone, in nanoseconds since the profiler was created
+struct ProfileEvent {
+    /// Name of the zone, which must outlive the profiler, e.g. a string literal or an interned string
+    const char *mName;
+    uint64_t mStart;
+    uint64_t mEnd;
+};
+
+/// Collects timed zones from every thread while recording, to find out where frame and tick time goes. Each thread
+/// writes to its own ring buffer, so only the latest zones of a long session are kept, and they can be written out as
+/// a Chrome trace at any time. Zones are added with PROFILE_ZONE, which costs one relaxed load while not recording and
+/// compiles to nothing without SURVIVAL_PROFILING
+class Profiler {
+  public:
+    /// Number of zones kept per thread
+    static const size_t EVENTS_PER_THREAD = 1 << 16;
+
+    /// Get the singleton instance
+    static Profiler &getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler(const Profiler &) = delete;
+    void operator=(const Profiler &) = delete;
+
+    /// Start or stop recording zones. Zones already recorded are kept
+    void setRecording(bool recording) { mRecording.store(recording, std::memory_order_relaxed); }
+    bool isRecording() const { return mRecording.load(std::memory_order_relaxed); }
+
+    /// Name the calling thread in traces
+    void setThreadName(const std::string &name);
+    /// Get a copy of name that lives as long as the profiler, to name zones with strings that are not literals.
+    /// Safe to call from any thread
+    const char *intern(const std::string &name);
+
+    /// Nanoseconds since the profiler was created
+    uint64_t now() const;
+    /// Add a zone to the calling thread's buffer, overwriting its oldest zone if the buffer is full
+    void record(const char *name, uint64_t start, uint64_t end);
+    /// Forget every recorded zone
+    void clear();
+
+    /// Write the recorded zones in the Chrome trace event format, which chrome://tracing and Perfetto can open. Safe
+    /// to call while other threads are recording
+    /// \return false if the file could not be written
+    bool writeChromeTrace(const std::string &path);
+
+  private:
+    Profiler();
+
+    struct ThreadBuffer {
+        /// Guards the events against being written out while the thread adds to them
+        std::mutex mMutex;
+        std::string mName;
+        unsigned mThreadID{0};
+        std::vector<ProfileEvent> mEvents;
+        /// Number of zones ever added, the latest is at (mNumRecorded - 1) % EVENTS_PER_THREAD
+        uint64_t mNumRecorded{0};
+    };
+
+    /// Get the calling thread's buffer, creating it on first use
+    ThreadBuffer &getThreadBuffer();
+
+    /// Buffer of the calling thread, once it has recorded a zone
+    static thread_local ThreadBuffer *tThreadBuffer;
+
+    std::atomic<bool> mRecording{false};
+    uint64_t mEpoch;
+
+    /// Guards the list of buffers and the interned names
+    std::mutex mMutex;
+    /// Buffers of every thread that has recorded a zone, kept after the thread exits so its zones can be written out
+    std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+    std::unordered_set<std::string> mInternedNames;
+};
+
+/// Times the scope it is declared in, if the profiler was recording when it was entered
+class ProfileZone {
+  public:
+    explicit ProfileZone(const char *name) {
+        auto &profiler = Profiler::getInstance();
+        if (profiler.isRecording()) {
+            mName = name;
+            mStart = profiler.now();
+        }
+    }
+
+    ~ProfileZone() {
+        if (mName != nullptr) {
+            auto &profiler = Profiler::getInstance();
+            profiler.record(mName, mStart, profiler.now());
+        }
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+  private:
+    const char *mName{nullptr};
+    uint64_t mStart{0};
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef SURVIVAL_PROFILING
+/// Time the rest of the enclosing scope as a zone called name, which must be a string literal
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+/// Time the rest of the enclosing scope as a zone named by a std::string, which is only copied while recording
+#define PROFILE_ZONE_DYNAMIC(name)                                                                                     \
+    ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(                                                                 \
+        Profiler::getInstance().isRecording() ? Profiler::getInstance().intern(name) : nullptr)
+#else
+#define PROFILE_ZONE(name) (void)0
+#define PROFILE_ZONE_DYNAMIC(name) (void)0
+#endif
@@ -5,6 +5,7 @@
 class AdditionalCarryWeightProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(AdditionalCarryWeight)
+    POOLED_ALLOCATION(AdditionalCarryWeightProperty)
 
     explicit AdditionalCarryWeightProperty(int additionalCarryWeight);
 
@@ -5,6 +5,7 @@
 class CraftingMaterialProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(CraftingMaterial)
+    POOLED_ALLOCATION(CraftingMaterialProperty)
 
     CraftingMaterialProperty(std::string type, float quality);
 
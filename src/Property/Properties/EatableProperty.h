@@ -5,6 +5,7 @@
 class EatableProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(Eatable)
+    POOLED_ALLOCATION(EatableProperty)
 
     explicit EatableProperty(float hungerRestoration);
 
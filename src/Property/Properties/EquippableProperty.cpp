@@ -1,5 +1,7 @@
 #include "EquippableProperty.h"
 
+#include <algorithm>
+
 EquippableProperty::EquippableProperty(std::vector<EquipmentSlot> equippableSlots)
     : m_equippableSlots(std::move(equippableSlots)) {}
 
@@ -7,6 +7,7 @@ enum class EquipmentSlot;
 class EquippableProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(Equippable)
+    POOLED_ALLOCATION(EquippableProperty)
 
     explicit EquippableProperty(std::vector<EquipmentSlot> equippableSlots);
 
@@ -1,10 +1,17 @@
 #include "LightEmittingProperty.h"
 #include "../../Entity/Entity.h"
+#include "../../Lighting/LightRegistry.h"
 
 LightEmittingProperty::LightEmittingProperty(Entity *parent, int radius, Color color)
-    : mParent(parent), mRadius(radius), mColor(color) {}
+    : mParent(parent), mRadius(radius), mColor(color) {
+    LightRegistry::getInstance().add(this);
+}
 LightEmittingProperty::LightEmittingProperty(Entity *parent, int radius)
-    : mParent(parent), mRadius(radius), mColor(Color{}) {}
+    : LightEmittingProperty(parent, radius, Color{}) {}
+
+LightEmittingProperty::~LightEmittingProperty() { LightRegistry::getInstance().remove(this); }
+
+Entity *LightEmittingProperty::getParent() const { return mParent; }
 
 int LightEmittingProperty::getRadius() const { return mRadius; }
 
@@ -4,15 +4,22 @@
 #include "../Property.h"
 
 struct Entity;
+/// Makes the parent entity emit light. Registers itself with the LightRegistry for as long as it exists
 class LightEmittingProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(LightEmitting)
+    POOLED_ALLOCATION(LightEmittingProperty)
 
     LightEmittingProperty(Entity *parent, int radius, Color color);
     LightEmittingProperty(Entity *parent, int radius);
+    ~LightEmittingProperty() override;
+    LightEmittingProperty(const LightEmittingProperty &) = delete;
+    void operator=(const LightEmittingProperty &) = delete;
 
+    [[nodiscard]] Entity *getParent() const;
     [[nodiscard]] bool isEnabled() const;
-    [[nodiscard]] int getRadius() const;
+    /// Radius of the light in cells, which subclasses may compute from the state of the parent
+    [[nodiscard]] virtual int getRadius() const;
     void setRadius(int radius);
     [[nodiscard]] Color getColor() const;
     void setColor(Color color);
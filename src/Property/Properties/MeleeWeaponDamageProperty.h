@@ -5,6 +5,7 @@
 class MeleeWeaponDamageProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(MeleeWeaponDamage)
+    POOLED_ALLOCATION(MeleeWeaponDamageProperty)
 
     explicit MeleeWeaponDamageProperty(int damage);
 
@@ -5,6 +5,7 @@
 class PickuppableProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(Pickuppable)
+    POOLED_ALLOCATION(PickuppableProperty)
 
     explicit PickuppableProperty(int weight = 1);
 
@@ -5,6 +5,7 @@
 class WaterContainerProperty : public Property {
   public:
     PROPERTY_SUBCLASS_BODY(WaterContainer)
+    POOLED_ALLOCATION(WaterContainerProperty)
 
     explicit WaterContainerProperty(int maxCapacity = 64);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../ObjectPool.h"
 #include <string>
 
 class Property {
@@ -0,0 +1,91 @@
+#include "Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+/// Scramble the bits of x (splitmix64), so that similar seeds give unrelated states
+uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27u)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31u);
+}
+} // namespace
+
+Pcg32::Pcg32(uint64_t seed, uint64_t stream) : mState(0), mIncrement(0) { this->seed(seed, stream); }
+
+void Pcg32::seed(uint64_t seed, uint64_t stream) {
+    mState = 0;
+    mIncrement = (stream << 1u) | 1u;
+    next();
+    mState += seed;
+    next();
+}
+
+uint32_t Pcg32::next() {
+    uint64_t oldState = mState;
+    mState = oldState * 6364136223846793005ULL + mIncrement;
+    auto xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+    auto rotation = static_cast<uint32_t>(oldState >> 59u);
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+}
+
+uint64_t Pcg32::next64() {
+    const uint64_t high = next();
+    return (high << 32u) | next();
+}
+
+uint32_t Pcg32::nextBelow(uint32_t bound) {
+    // Reject the low values that would make some results more likely than others
+    uint32_t threshold = -bound % bound;
+    for (;;) {
+        uint32_t r = next();
+        if (r >= threshold)
+            return r % bound;
+    }
+}
+
+double Pcg32::nextDouble() { return next() * (1.0 / 4294967296.0); }
+
+int Pcg32::nextGeometric(double p) {
+    if (p >= 1)
+        return 0;
+    if (p <= 0)
+        return std::numeric_limits<int>::max();
+    // Invert the CDF, using 1 - u in (0, 1] so that the log is finite
+    double u = 1 - nextDouble();
+    return static_cast<int>(
+        std::min(std::floor(std::log(u) / std::log(1 - p)), static_cast<double>(std::numeric_limits<int>::max())));
+}
+
+double Pcg32::nextGaussian() {
+    // Box-Muller transform, using 1 - u in (0, 1] so that the log is finite
+    double u = 1 - nextDouble();
+    double v = nextDouble();
+    return std::sqrt(-2 * std::log(u)) * std::cos(2 * M_PI * v);
+}
+
+uint64_t hashSeed(const std::string &str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+RandomStreams::RandomStreams() { setWorldSeed(0); }
+
+void RandomStreams::setWorldSeed(uint64_t seed) {
+    mWorldSeed = seed;
+    for (uint64_t i = 0; i < static_cast<uint64_t>(RandomStream::ENTITY_IDS); ++i)
+        mStreams[i].seed(mix(seed), i + 1);
+}
+
+Pcg32 &RandomStreams::getStream(RandomStream stream) { return mStreams[static_cast<size_t>(stream) - 1]; }
+
+Pcg32 RandomStreams::makeStream(RandomStream stream, const std::string &name) const {
+    return Pcg32(mix(mWorldSeed ^ hashSeed(name)), static_cast<uint64_t>(stream));
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/// Small, fast PCG32 random number generator (see pcg-random.org). Its state is only 16 bytes so that every entity can
+/// own a generator, which makes the numbers an entity draws independent of the order entities are ticked in
+class Pcg32 {
+  public:
+    /// Initialize the generator
+    /// \param seed starting state
+    /// \param stream selects one of 2^63 independent sequences
+    explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+    /// Restart the generator from seed on the given stream
+    void seed(uint64_t seed, uint64_t stream);
+
+    /// Get the next uniformly distributed 32 bit number
+    uint32_t next();
+    /// Get a uniformly distributed 64 bit number from the next two 32 bit numbers
+    uint64_t next64();
+    /// Get a uniformly distributed number in [0, bound), bound must be at least 1
+    uint32_t nextBelow(uint32_t bound);
+    /// Get a uniformly distributed number in [0, 1)
+    double nextDouble();
+    /// Number of failed trials before the first success, where each trial succeeds with probability p
+    int nextGeometric(double p);
+    /// Get a normally distributed number with mean 0 and standard deviation 1
+    double nextGaussian();
+
+  private:
+    uint64_t mState;
+    uint64_t mIncrement;
+};
+
+/// Hash a string to a 64 bit seed (FNV-1a), so that seeds derived from names are the same on every platform
+uint64_t hashSeed(const std::string &str);
+
+/// The subsystems that draw random numbers. Each has its own streams, so that drawing more numbers in one subsystem
+/// never changes the numbers drawn in another
+enum class RandomStream : uint64_t {
+    /// Floor tiles and entities of each screen
+    WORLD_GENERATION = 1,
+    /// Decisions of each entity's behaviours
+    AI,
+    /// Damage rolls of each entity
+    COMBAT,
+    /// Purely visual choices such as animation frames, which may be drawn any number of times per tick
+    COSMETIC,
+    /// IDs of entities created without one
+    ENTITY_IDS
+};
+
+/// Source of every random number in the game, all derived from a single world seed so that a game can be reproduced
+class RandomStreams {
+  public:
+    /// Get the singleton instance
+    static RandomStreams &getInstance() {
+        static RandomStreams instance;
+        return instance;
+    }
+
+    RandomStreams(const RandomStreams &) = delete;
+    void operator=(const RandomStreams &) = delete;
+
+    /// Set the world seed and restart every shared stream. Must be called before anything is generated
+    void setWorldSeed(uint64_t seed);
+    uint64_t getWorldSeed() const { return mWorldSeed; }
+
+    /// Get the generator shared by the whole subsystem. Not thread-safe, so only for use on the simulation thread
+    Pcg32 &getStream(RandomStream stream);
+
+    /// Make a generator for one member of a subsystem, e.g. a screen or an entity, that is independent of every other
+    /// member's. Safe to call from any thread
+    /// \param stream the subsystem
+    /// \param name unique name of the member within the subsystem
+    Pcg32 makeStream(RandomStream stream, const std::string &name) const;
+
+  private:
+    RandomStreams();
+
+    uint64_t mWorldSeed{0};
+    /// Shared generators indexed by RandomStream - 1
+    Pcg32 mStreams[static_cast<size_t>(RandomStream::ENTITY_IDS)];
+};
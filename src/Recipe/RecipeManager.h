@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Recipe.h"
+#include <memory>
 #include <vector>
 
 struct RecipeManager {
@@ -0,0 +1,21 @@
+#include "RenderBackend.h"
+#include "PerformanceStats.h"
+#include "RenderSnapshot.h"
+
+void RenderBackend::drawGlyphs(const std::vector<GlyphCommand> &commands) {
+    for (const auto &command : commands)
+        drawGlyph(command);
+}
+
+void RenderBackend::drawSnapshot(const RenderSnapshot &snapshot) {
+    {
+        PhaseTimer timer(FramePhase::PRESENT);
+        drawGlyphs(snapshot.mWorldGlyphs);
+    }
+    if (snapshot.mRenderWorld) {
+        PhaseTimer timer(FramePhase::LIGHTING);
+        drawLightMap(snapshot.mLights, snapshot.mLightMapAlpha);
+    }
+    PhaseTimer timer(FramePhase::PRESENT);
+    drawGlyphs(snapshot.mUIGlyphs);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct GlyphCommand;
+struct LightMapPoint;
+struct RenderSnapshot;
+/// Draws recorded frames of the game to a screen. The game only records what to draw into RenderSnapshots, and the
+/// frontend implements this to draw them with whatever graphics library it uses
+class RenderBackend {
+  public:
+    virtual ~RenderBackend() = default;
+
+    /// Start a new frame, cleared to black
+    virtual void beginFrame() = 0;
+    /// Fill the glyph's cell with its background color, then draw the glyph over it in its foreground color
+    virtual void drawGlyph(const GlyphCommand &command) = 0;
+    /// Darken everything drawn so far by the time-of-day fog, except where it is lit
+    /// \param lights the light sources on the screen, in screen cell coordinates
+    /// \param fogAlpha the alpha value of the fog
+    virtual void drawLightMap(const std::vector<LightMapPoint> &lights, uint8_t fogAlpha) = 0;
+    /// Show the finished frame
+    virtual void endFrame() = 0;
+
+    /// Draw the glyphs in order
+    void drawGlyphs(const std::vector<GlyphCommand> &commands);
+    /// Draw the world, then the light map over it if the world is shown, then the UI on top
+    void drawSnapshot(const RenderSnapshot &snapshot);
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Color.h"
+#include "LightMapPoint.h"
+
+#include <vector>
+
+/// A single glyph to draw, with its position on the font texture already looked up
+struct GlyphCommand {
+    /// Cell of the glyph on the font texture
+    int mGlyphX;
+    int mGlyphY;
+    /// Screen cell to draw the glyph in
+    int mX;
+    int mY;
+    Color mForeground;
+    Color mBackground;
+};
+
+/// Everything needed to draw one frame of the game. Recorded by the simulation thread after it has handled input and
+/// then published to the render thread, which only ever reads it
+struct RenderSnapshot {
+    /// Whether the world and the light map are drawn, false when a screen covering the world is open
+    bool mRenderWorld{false};
+    /// Glyphs of the floor and entities, drawn underneath the light map
+    std::vector<GlyphCommand> mWorldGlyphs;
+    /// Light sources on screen, in screen cell coordinates
+    std::vector<LightMapPoint> mLights;
+    /// Alpha of the time-of-day fog
+    uint8_t mLightMapAlpha{0};
+    /// Glyphs of the UI, drawn on top of the light map
+    std::vector<GlyphCommand> mUIGlyphs;
+
+    /// Empty the snapshot, keeping the storage of the vectors so that recording the next frame does not allocate
+    void clear() {
+        mRenderWorld = false;
+        mWorldGlyphs.clear();
+        mLights.clear();
+        mLightMapAlpha = 0;
+        mUIGlyphs.clear();
+    }
+};
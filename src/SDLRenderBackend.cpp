@@ -0,0 +1,63 @@
+#include "SDLRenderBackend.h"
+#include "RenderSnapshot.h"
+#include "SDLManager.h"
+
+SDLRenderBackend::SDLRenderBackend(SDL_Renderer *renderer)
+    : mRenderer(renderer), mFontTexture(renderer), mLightMapTexture(renderer) {
+    //    mFontTexture.loadFromFile("resources/curses_800x600.bmp");
+    mFontTexture.loadFromFile(std::string(SDL_GetBasePath()) + "resources/cursesV2_800x600.bmp");
+
+    mRenderTexture =
+        SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_BGRA32, SDL_TEXTUREACCESS_TARGET, WINDOW_WIDTH, WINDOW_HEIGHT);
+    SDL_SetTextureBlendMode(mRenderTexture, SDL_BLENDMODE_BLEND);
+}
+
+SDLRenderBackend::~SDLRenderBackend() {
+    if (mRenderTexture != nullptr)
+        SDL_DestroyTexture(mRenderTexture);
+}
+
+void SDLRenderBackend::beginFrame() {
+    SDL_SetRenderTarget(mRenderer, mRenderTexture);
+
+    SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 0xFF);
+    SDL_RenderClear(mRenderer);
+}
+
+void SDLRenderBackend::drawGlyph(const GlyphCommand &command) {
+    const Color &fColor = command.mForeground;
+    SDL_SetTextureColorMod(mFontTexture.getTexture(), fColor.r, fColor.g, fColor.b);
+    SDL_SetTextureAlphaMod(mFontTexture.getTexture(), fColor.a);
+
+    SDL_FRect srcRect = {
+        static_cast<float>(command.mGlyphX * CHAR_WIDTH),
+        static_cast<float>(command.mGlyphY * CHAR_HEIGHT),
+        static_cast<float>(CHAR_WIDTH),
+        static_cast<float>(CHAR_HEIGHT),
+    };
+    SDL_FRect destRect = {
+        static_cast<float>(command.mX * CHAR_WIDTH),
+        static_cast<float>(command.mY * CHAR_HEIGHT),
+        static_cast<float>(CHAR_WIDTH),
+        static_cast<float>(CHAR_HEIGHT),
+    };
+
+    const Color &bColor = command.mBackground;
+    SDL_SetRenderDrawColor(mRenderer, bColor.r, bColor.g, bColor.b, bColor.a);
+    SDL_RenderFillRect(mRenderer, &destRect);
+
+    mFontTexture.render(&srcRect, &destRect);
+}
+
+void SDLRenderBackend::drawLightMap(const std::vector<LightMapPoint> &lights, uint8_t fogAlpha) {
+    mLightMapTexture.render(lights, fogAlpha);
+}
+
+void SDLRenderBackend::endFrame() {
+    SDL_SetRenderTarget(mRenderer, nullptr);
+    SDL_RenderTexture(mRenderer, mRenderTexture, nullptr, nullptr);
+
+    SDL_RenderPresent(mRenderer);
+}
+
+bool SDLRenderBackend::setVSync(bool enabled) { return SDL_SetRenderVSync(mRenderer, enabled ? 1 : 0); }
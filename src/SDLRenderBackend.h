@@ -0,0 +1,37 @@
+#pragma once
+
+#include "LightMapTexture.h"
+#include "RenderBackend.h"
+#include "Texture.h"
+
+#include <SDL3/SDL.h>
+
+/// Draws frames with an SDL_Renderer, using the bitmap font texture for glyphs. Each frame is drawn onto an off-screen
+/// texture which is then stretched over the window, so that the window can be resized
+class SDLRenderBackend : public RenderBackend {
+  public:
+    /// Load the font and light textures for drawing onto renderer
+    explicit SDLRenderBackend(SDL_Renderer *renderer);
+
+    // Delete copy constructor and copy assignment
+    SDLRenderBackend(const SDLRenderBackend &) = delete;
+    SDLRenderBackend &operator=(const SDLRenderBackend &) = delete;
+
+    ~SDLRenderBackend() override;
+
+    void beginFrame() override;
+    void drawGlyph(const GlyphCommand &command) override;
+    void drawLightMap(const std::vector<LightMapPoint> &lights, uint8_t fogAlpha) override;
+    void endFrame() override;
+
+    /// Make presenting a frame wait for the display's vertical sync
+    /// \return false if the renderer cannot
+    bool setVSync(bool enabled);
+
+  private:
+    SDL_Renderer *mRenderer;
+    /// The entire font texture
+    Texture mFontTexture;
+    LightMapTexture mLightMapTexture;
+    SDL_Texture *mRenderTexture{nullptr};
+};
@@ -0,0 +1,55 @@
+#include "SimulationLOD.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+const int SimulationLOD::FULL_RADIUS;
+const int SimulationLOD::COARSE_RADIUS;
+const unsigned long SimulationLOD::COARSE_INTERVAL;
+
+SimulationTier SimulationLOD::getTier(const Point &worldPos, const Point &playerWorldPos) {
+    const auto diff = worldPos - playerWorldPos;
+    const int distance = std::max(std::abs(diff.mX), std::abs(diff.mY));
+    if (distance <= FULL_RADIUS)
+        return SimulationTier::FULL;
+    if (distance <= COARSE_RADIUS)
+        return SimulationTier::COARSE;
+    return SimulationTier::DORMANT;
+}
+
+void SimulationLOD::addScreen(const Point &worldPos, unsigned long tick) { mSimulatedUntil.emplace(worldPos, tick); }
+
+void SimulationLOD::update(unsigned long tick, const Point &playerWorldPos, std::vector<CatchUp> &out) {
+    out.clear();
+    for (auto &screen : mSimulatedUntil) {
+        const auto &worldPos = screen.first;
+        auto &simulatedUntil = screen.second;
+        if (simulatedUntil >= tick)
+            continue;
+
+        switch (getTier(worldPos, playerWorldPos)) {
+        case SimulationTier::FULL:
+            // This tick is simulated in full, so only the ticks before it were missed, if the screen was further away
+            if (simulatedUntil + 1 < tick)
+                out.push_back({worldPos, tick - 1 - simulatedUntil});
+            simulatedUntil = tick;
+            break;
+        case SimulationTier::COARSE: {
+            // Spread the coarse screens over the interval, so that they are not all caught up on the same tick
+            const auto phase = static_cast<unsigned long>(std::abs(worldPos.mX * 7 + worldPos.mY * 13));
+            if ((tick + phase) % COARSE_INTERVAL == 0) {
+                out.push_back({worldPos, tick - simulatedUntil});
+                simulatedUntil = tick;
+            }
+            break;
+        }
+        case SimulationTier::DORMANT:
+            break;
+        }
+    }
+
+    // The screens are caught up one after another, so make the order independent of the hash map's
+    std::sort(out.begin(), out.end(), [](const CatchUp &a, const CatchUp &b) {
+        return a.mWorldPos.mY < b.mWorldPos.mY || (a.mWorldPos.mY == b.mWorldPos.mY && a.mWorldPos.mX < b.mWorldPos.mX);
+    });
+}
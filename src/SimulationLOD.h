@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Point.h"
+
+#include <unordered_map>
+#include <vector>
+
+/// How closely the entities on a screen are simulated, depending on how far the screen is from the player's
+enum class SimulationTier {
+    /// Awake entities are ticked every tick
+    FULL,
+    /// Entities are caught up every COARSE_INTERVAL ticks
+    COARSE,
+    /// Entities are left alone until the screen comes within COARSE_RADIUS again, then caught up in one step
+    DORMANT
+};
+
+/// Keeps track of the last tick that each screen was simulated up to, and decides which screens must be caught up on
+/// each tick. Catching up a screen calls Entity::catchUp() on its entities with the number of ticks missed, which
+/// applies the overall effect of those ticks, such as regenerating or wandering, without ticking them one at a time
+class SimulationLOD {
+  public:
+    /// Screens at most this far from the player's screen, in screens along either axis, are fully simulated. Matches
+    /// the screens that EntityManager::tick() ticks
+    static const int FULL_RADIUS = 1;
+    /// Screens further away than FULL_RADIUS but at most this far are coarsely simulated
+    static const int COARSE_RADIUS = 3;
+    /// Number of ticks between each catch up of a coarsely simulated screen
+    static const unsigned long COARSE_INTERVAL = 20;
+
+    /// A screen that must be caught up
+    struct CatchUp {
+        Point mWorldPos;
+        /// Number of ticks that the screen missed
+        unsigned long mTicks;
+    };
+
+    /// Get the tier of the screen at worldPos when the player is on the screen at playerWorldPos
+    static SimulationTier getTier(const Point &worldPos, const Point &playerWorldPos);
+
+    /// Start tracking the screen at worldPos as simulated up to tick, if it is not tracked already
+    void addScreen(const Point &worldPos, unsigned long tick);
+
+    /// Find the screens that must be caught up before the entities are ticked on tick, and mark them simulated up to
+    /// tick. Must be called once for every tick, in order
+    /// \param tick the tick that has just started
+    /// \param playerWorldPos the player's screen
+    /// \param out cleared and then filled with the screens to catch up, in a fixed order
+    void update(unsigned long tick, const Point &playerWorldPos, std::vector<CatchUp> &out);
+
+    /// Stop tracking every screen
+    void clear() { mSimulatedUntil.clear(); }
+
+  private:
+    /// Last tick that each screen was simulated up to
+    std::unordered_map<Point, unsigned long> mSimulatedUntil;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// A view of contiguous elements owned by something else, e.g. scratch memory in an Arena. Cheap to copy, and only
+/// valid for as long as the elements are
+template <typename T> class Span {
+  public:
+    Span() = default;
+    Span(T *data, size_t size) : mData(data), mSize(size) {}
+    /// View the elements of vector, which must not grow while the span is in use
+    template <typename Allocator>
+    Span(std::vector<T, Allocator> &vector) : mData(vector.data()), mSize(vector.size()) {}
+
+    T *data() const { return mData; }
+    size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+
+    T *begin() const { return mData; }
+    T *end() const { return mData + mSize; }
+    const T *cbegin() const { return mData; }
+    const T *cend() const { return mData + mSize; }
+    T &operator[](size_t index) const { return mData[index]; }
+    T &front() const { return mData[0]; }
+    T &back() const { return mData[mSize - 1]; }
+
+  private:
+    T *mData{nullptr};
+    size_t mSize{0};
+};
@@ -0,0 +1,62 @@
+#include "SpatialIndex.h"
+#include "Entity/Entity.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+int floorDiv(int a, int b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+
+void eraseFrom(std::vector<Entity *> &bucket, Entity *entity) {
+    auto it = std::find(bucket.begin(), bucket.end(), entity);
+    if (it != bucket.end()) {
+        // Order within a bucket doesn't matter
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+}
+} // namespace
+
+Point SpatialIndex::getBucket(const Point &pos) { return {floorDiv(pos.mX, BUCKET_SIZE), floorDiv(pos.mY, BUCKET_SIZE)}; }
+
+void SpatialIndex::insert(Entity *entity) { mBuckets[getBucket(entity->getPos())].push_back(entity); }
+
+void SpatialIndex::remove(Entity *entity) {
+    auto it = mBuckets.find(getBucket(entity->getPos()));
+    if (it != mBuckets.end())
+        eraseFrom(it->second, entity);
+}
+
+void SpatialIndex::move(Entity *entity, const Point &oldPos) {
+    const Point oldBucket = getBucket(oldPos);
+    const Point newBucket = getBucket(entity->getPos());
+    if (oldBucket == newBucket)
+        return;
+
+    eraseFrom(mBuckets[oldBucket], entity);
+    mBuckets[newBucket].push_back(entity);
+}
+
+void SpatialIndex::query(const Point &center, float radius, Tag tag, std::vector<Entity *> &out) const {
+    out.clear();
+
+    const int reach = static_cast<int>(std::ceil(radius));
+    const Point minBucket = getBucket(center - Point(reach, reach));
+    const Point maxBucket = getBucket(center + Point(reach, reach));
+    const float radiusSquared = radius * radius;
+
+    for (int y = minBucket.mY; y <= maxBucket.mY; ++y) {
+        for (int x = minBucket.mX; x <= maxBucket.mX; ++x) {
+            auto it = mBuckets.find(Point(x, y));
+            if (it == mBuckets.end())
+                continue;
+
+            for (auto entity : it->second) {
+                if ((tag != NO_TAG && entity->mArchetype != tag) || entity->mIsInAnInventory)
+                    continue;
+                if (static_cast<float>(center.distanceSquaredTo(entity->getPos())) < radiusSquared)
+                    out.push_back(entity);
+            }
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Point.h"
+#include "Tag.h"
+
+#include <unordered_map>
+#include <vector>
+
+struct Entity;
+/// Buckets entities into square cells of the world so that entities near a point can be found without visiting every
+/// entity. Entities must be moved in the index whenever their position changes
+class SpatialIndex {
+  public:
+    /// Width and height of each bucket in world cells
+    static const int BUCKET_SIZE = 16;
+
+    /// Add entity at its current position
+    void insert(Entity *entity);
+    /// Remove entity, which must be at the position it was last inserted or moved to
+    void remove(Entity *entity);
+    /// Update the bucket of entity after it moved from oldPos to its current position
+    void move(Entity *entity, const Point &oldPos);
+
+    /// Find the entities with archetype tag (or any archetype if tag is NO_TAG) strictly closer than radius to center,
+    /// skipping entities that are inside an inventory
+    /// \param out cleared and then filled with the matching entities
+    void query(const Point &center, float radius, Tag tag, std::vector<Entity *> &out) const;
+
+  private:
+    /// Get the bucket containing the world position pos, rounding towards negative infinity
+    static Point getBucket(const Point &pos);
+
+    std::unordered_map<Point, std::vector<Entity *>> mBuckets;
+};
@@ -0,0 +1,30 @@
+#include "Tag.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace {
+struct TagTable {
+    std::unordered_map<std::string, Tag> mTags{{"", NO_TAG}};
+    std::vector<std::string> mNames{""};
+};
+
+TagTable &getTagTable() {
+    static TagTable table;
+    return table;
+}
+} // namespace
+
+Tag internTag(const std::string &name) {
+    auto &table = getTagTable();
+    auto it = table.mTags.find(name);
+    if (it != table.mTags.end())
+        return it->second;
+
+    auto tag = static_cast<Tag>(table.mNames.size());
+    table.mTags.emplace(name, tag);
+    table.mNames.push_back(name);
+    return tag;
+}
+
+const std::string &getTagName(Tag tag) { return getTagTable().mNames.at(tag); }
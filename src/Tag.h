@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/// An interned string, so that entity kinds can be compared as integers rather than by string comparison
+using Tag = uint32_t;
+
+/// The empty string, which when querying matches every tag
+const Tag NO_TAG = 0;
+
+/// Get the tag for name, allocating a new one the first time name is seen
+Tag internTag(const std::string &name);
+
+/// Get the string that tag was interned from
+const std::string &getTagName(Tag tag);
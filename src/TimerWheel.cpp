@@ -0,0 +1,21 @@
+#include "TimerWheel.h"
+
+const int TimerWheel::NUM_SLOTS;
+
+TimerWheel::TimerWheel() : mSlots(NUM_SLOTS) {}
+
+void TimerWheel::schedule(unsigned long tick, const std::string &ID) { mSlots[tick % NUM_SLOTS].emplace_back(tick, ID); }
+
+void TimerWheel::advance(unsigned long tick, std::vector<std::string> &due) {
+    auto &slot = mSlots[tick % NUM_SLOTS];
+
+    // Keep the wake-ups belonging to later laps of the wheel, compacting them to the front of the slot
+    size_t kept = 0;
+    for (auto &wakeUp : slot) {
+        if (wakeUp.first <= tick)
+            due.push_back(std::move(wakeUp.second));
+        else
+            slot[kept++] = std::move(wakeUp);
+    }
+    slot.resize(kept);
+}
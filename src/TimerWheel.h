@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Hashed timer wheel of entity wake-ups. A wake-up due at tick t lives in slot t % NUM_SLOTS, so advancing one tick
+/// only visits the wake-ups in a single slot. Wake-ups more than NUM_SLOTS ticks away stay in their slot until the
+/// wheel comes round to the right lap
+class TimerWheel {
+  public:
+    /// Number of slots in the wheel
+    static const int NUM_SLOTS = 256;
+
+    TimerWheel();
+
+    /// Wake the entity with ID at the given tick
+    /// \param tick game tick to wake at, which should be after the current tick
+    /// \param ID ID of the entity to wake
+    void schedule(unsigned long tick, const std::string &ID);
+
+    /// Collect the wake-ups that are due at tick. Must be called once for every tick, in order
+    /// \param tick the tick that has just started
+    /// \param due IDs of the entities to wake are appended to this
+    void advance(unsigned long tick, std::vector<std::string> &due);
+
+  private:
+    std::vector<std::vector<std::pair<unsigned long, std::string>>> mSlots;
+};
@@ -4,6 +4,8 @@
 #include "../World.h"
 #include "../utils.h"
 
+#include <algorithm>
+
 void showMessageBox(Font &font, const std::vector<std::string> &contents, int padding, int x, int y) {
     int maxNumChars = 0;
 
@@ -37,14 +39,23 @@ void showMessageBox(Font &font, const std::vector<std::string> &contents, int pa
 }
 
 void MessageBoxRenderer::queueMessageBox(const std::vector<std::string> &contents, int padding, int x, int y) {
-    mRenderingQueue.push_back(MessageBoxData{contents, padding, x, y});
+    if (mNumQueued == mRenderingQueue.size()) {
+        mRenderingQueue.push_back(MessageBoxData{contents, padding, x, y});
+    } else {
+        // Assigning reuses the storage of the lines of the box that was here
+        auto &data = mRenderingQueue[mNumQueued];
+        data.mContents = contents;
+        data.mPadding = padding;
+        data.mX = x;
+        data.mY = y;
+    }
+    ++mNumQueued;
 }
 
 void MessageBoxRenderer::queueMessageBoxCentered(const std::vector<std::string> &contents, int padding) {
-    std::vector<int> lineLengths;
-    std::transform(contents.cbegin(), contents.cend(), std::back_inserter(lineLengths),
-                   [](const auto &a) { return Font::getFontStringLength(a); });
-    const int maxLength = *std::max_element(lineLengths.cbegin(), lineLengths.cend());
+    int maxLength = 0;
+    for (const auto &line : contents)
+        maxLength = std::max(maxLength, Font::getFontStringLength(line));
     const int width = maxLength + 2 * padding;
     const int height = static_cast<int>(contents.size()) + 2 * padding;
 
@@ -52,10 +63,9 @@ void MessageBoxRenderer::queueMessageBoxCentered(const std::vector<std::string>
 }
 
 void MessageBoxRenderer::render(Font &font) {
-    while (!mRenderingQueue.empty()) {
-        auto data = mRenderingQueue.front();
-        mRenderingQueue.pop_front();
-
+    for (size_t i = 0; i < mNumQueued; ++i) {
+        const auto &data = mRenderingQueue[i];
         showMessageBox(font, data.mContents, data.mPadding, data.mX, data.mY);
     }
+    mNumQueued = 0;
 }
@@ -1,5 +1,5 @@
 #pragma once
-#include <deque>
+#include <string>
 #include <vector>
 
 class Font;
@@ -36,5 +36,8 @@ struct MessageBoxRenderer {
         int mY;
     };
 
-    std::deque<MessageBoxData> mRenderingQueue{};
+    /// Message boxes to draw, of which the first mNumQueued are queued. The rest are kept so that their contents'
+    /// storage is reused by the next boxes queued
+    std::vector<MessageBoxData> mRenderingQueue{};
+    size_t mNumQueued{0};
 };
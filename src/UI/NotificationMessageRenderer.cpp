@@ -1,7 +1,9 @@
 #include "NotificationMessageRenderer.h"
+#include "../AllocationCounter.h"
 #include "../Font.h"
 
 void NotificationMessageRenderer::queueMessage(const std::string &message) {
+    ALLOCATION_ZONE("NotificationMessageRenderer::queueMessage");
     mMessagesToBeRendered.push_back(message);
     if (mMessagesToBeRendered.size() > (size_t)cMaxOnScreen)
         mMessagesToBeRendered.pop_front();
@@ -9,15 +11,16 @@ void NotificationMessageRenderer::queueMessage(const std::string &message) {
 }
 
 void NotificationMessageRenderer::render(Font &font) {
-    auto currentTime = clock();
+    ALLOCATION_ZONE("NotificationMessageRenderer::render");
+    auto currentTime = FrameClock::getInstance().now();
 
     auto front = mMessagesToBeRendered.cbegin();
     for (int i = 0; front != mMessagesToBeRendered.cend() && i < cMaxOnScreen; ++i, ++front) {
         font.drawText(*front, 4, cInitialYPos - static_cast<int>(mMessagesToBeRendered.size()) + i,
                       i == 0 ? static_cast<int>(0xFF * mAlpha) : -1);
 
-        if (i == 0) // TODO: why is alpha decay slower when in a menu?
-            mAlpha -= cAlphaDecayPerSec * static_cast<float>(currentTime - previousTime) / CLOCKS_PER_SEC;
+        if (i == 0)
+            mAlpha -= cAlphaDecayPerSec * static_cast<float>(currentTime - previousTime);
     }
 
     if (mAlpha <= 0) {
@@ -1,4 +1,5 @@
 #pragma once
+#include "../FrameClock.h"
 #include "../World.h"
 #include <deque>
 #include <string>
@@ -9,7 +10,7 @@ struct NotificationMessageRenderer {
         return instance;
     }
 
-    NotificationMessageRenderer() { previousTime = clock(); }
+    NotificationMessageRenderer() { previousTime = FrameClock::getInstance().now(); }
 
     NotificationMessageRenderer(const NotificationMessageRenderer &) = delete;
     void operator=(const NotificationMessageRenderer &) = delete;
@@ -26,5 +27,6 @@ struct NotificationMessageRenderer {
     std::deque<std::string> mMessagesToBeRendered{};
     std::deque<std::string> mAllMessages{};
     float mAlpha{1};
-    clock_t previousTime{0};
+    /// Seconds on the frame clock when the messages were last drawn
+    double previousTime{0};
 };
@@ -0,0 +1,85 @@
+#include "PerformanceOverlayRenderer.h"
+
+#include "../Entity/EntityManager.h"
+#include "../FrameClock.h"
+#include "../PerformanceStats.h"
+#include "MessageBoxRenderer.h"
+
+#include <cstdio>
+
+namespace {
+const char *getPhaseName(FramePhase phase) {
+    switch (phase) {
+    case FramePhase::SIMULATE:
+        return "simulate";
+    case FramePhase::WORLD_RENDER:
+        return "world";
+    case FramePhase::ENTITY_RENDER:
+        return "entities";
+    case FramePhase::LIGHTING:
+        return "lighting";
+    case FramePhase::UI:
+        return "ui";
+    case FramePhase::PRESENT:
+        return "present";
+    case FramePhase::FRAME:
+        return "frame";
+    }
+    return "";
+}
+} // namespace
+
+void PerformanceOverlayRenderer::render(Font &font) {
+    auto &stats = PerformanceStats::getInstance();
+    if (!stats.isOverlayEnabled())
+        return;
+
+    auto &manager = EntityManager::getInstance();
+    char line[64];
+    mLines.clear();
+
+    mLines.emplace_back("$[yellow]ms/frame   last   p50   p95   p99");
+    for (size_t i = 0; i < NUM_FRAME_PHASES; ++i) {
+        auto phase = static_cast<FramePhase>(i);
+        auto summary = stats.getSummary(phase);
+        std::snprintf(line, sizeof(line), "%-9s %6.2f%6.2f%6.2f%6.2f", getPhaseName(phase), summary.mLast,
+                      summary.mP50, summary.mP95, summary.mP99);
+        mLines.emplace_back(line);
+    }
+
+    // Frames taking half as long again as they should are visibly late
+    auto &clock = FrameClock::getInstance();
+    auto histogram = clock.getHistogram();
+    std::snprintf(line, sizeof(line), "paced     p99 %.1f ms, %llu of %llu late",
+                  1000.0 * histogram.getPercentile(0.99),
+                  static_cast<unsigned long long>(histogram.countLongerThan(1.5 / clock.getTargetFrameRate())),
+                  static_cast<unsigned long long>(histogram.getCount()));
+    mLines.emplace_back(line);
+
+    const auto &timings = manager.getLastTickTimings();
+    std::snprintf(line, sizeof(line), "entities  %d total, %zu ticked, %zu caught up", gNumInitialisedEntities,
+                  timings.mNumTicked, timings.mNumCaughtUp);
+    mLines.emplace_back(line);
+    std::snprintf(line, sizeof(line), "queries   %llu per tick",
+                  static_cast<unsigned long long>(timings.mNumSpatialQueries));
+    mLines.emplace_back(line);
+    if (isCountingAllocations()) {
+        std::snprintf(line, sizeof(line), "allocs    %llu per tick, %.1f KiB",
+                      static_cast<unsigned long long>(timings.mAllocations.mAllocations),
+                      static_cast<double>(timings.mAllocations.mBytes) / 1024.0);
+        mLines.emplace_back(line);
+
+        auto allocations = stats.getFrameAllocations();
+        std::snprintf(line, sizeof(line), "allocs    %llu per frame, %.1f KiB",
+                      static_cast<unsigned long long>(allocations.mAllocations),
+                      static_cast<double>(allocations.mBytes) / 1024.0);
+        mLines.emplace_back(line);
+    } else {
+        mLines.emplace_back("allocs    not counted without SURVIVAL_PROFILING");
+    }
+    std::snprintf(line, sizeof(line), "memory    %.1f MiB resident",
+                  static_cast<double>(PerformanceStats::getResidentMemory()) / (1024.0 * 1024.0));
+    mLines.emplace_back(line);
+
+    showMessageBox(font, mLines, 0, 0, 0);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Font;
+/// Draws frame times, entity and query counts, allocations and memory in the top left corner, over everything but
+/// message boxes. Toggled from the debug screen
+struct PerformanceOverlayRenderer {
+    static PerformanceOverlayRenderer &getInstance() {
+        static PerformanceOverlayRenderer instance;
+        return instance;
+    }
+
+    PerformanceOverlayRenderer() = default;
+    PerformanceOverlayRenderer(const PerformanceOverlayRenderer &) = delete;
+    void operator=(const PerformanceOverlayRenderer &) = delete;
+
+    /// Draw the overlay if it is enabled in PerformanceStats
+    void render(Font &font);
+
+  private:
+    /// Lines of the overlay, kept between frames so that they do not have to be reallocated
+    std::vector<std::string> mLines;
+};
@@ -3,12 +3,14 @@
 #include "../../Color.h"
 #include "../../Entity/EntityManager.h"
 #include "../../Entity/PlayerEntity.h"
+#include "../../EventBus.h"
+#include "../../Events.h"
 #include "../../Font.h"
 #include "../../Property/Properties/CraftingMaterialProperty.h"
 #include "../../Recipe/RecipeManager.h"
 #include "../NotificationMessageRenderer.h"
 
-void CraftingScreen::handleInput(SDL_KeyboardEvent &e) {
+void CraftingScreen::handleInput(KeyEvent &e) {
     auto newState = mState->handleInput(*this, e);
     if (newState != nullptr) {
         mState->onExit(*this);
@@ -75,11 +77,11 @@ void CraftingScreen::render(Font &font) {
     }
 
     if (mLayer == CraftingLayer::INGREDIENT || mLayer == CraftingLayer::MATERIAL) {
-        std::vector<Entity *> inventoryMaterials = filterInventoryForChosenMaterials();
+        auto inventoryMaterials = filterInventoryForChosenMaterials();
 
-        for (std::vector<Entity *>::size_type i = 0; i < inventoryMaterials.size(); ++i) {
+        for (size_t i = 0; i < inventoryMaterials.size(); ++i) {
             Color bColor;
-            auto &material = inventoryMaterials.at(i);
+            auto &material = inventoryMaterials[i];
 
             if (mLayer == CraftingLayer::MATERIAL && i == (size_t)mChosenMaterial) {
                 bColor = Color::getColor("blue");
@@ -90,10 +92,10 @@ void CraftingScreen::render(Font &font) {
     }
 }
 
-std::vector<Entity *> CraftingScreen::filterInventoryForChosenMaterials() {
+Span<Entity *> CraftingScreen::filterInventoryForChosenMaterials() {
     auto &rm = RecipeManager::getInstance();
 
-    std::vector<Entity *> inventoryMaterials;
+    ArenaVector<Entity *> inventoryMaterials{ArenaAllocator<Entity *>(Arena::getFrameArena())};
     auto inventory = mPlayer.getInventory();
     std::copy_if(inventory.cbegin(), inventory.cend(), std::back_inserter(inventoryMaterials),
                  [this, &rm](const Entity *a) {
@@ -107,7 +109,7 @@ std::vector<Entity *> CraftingScreen::filterInventoryForChosenMaterials() {
                      return rm.mRecipes[mChosenRecipe]->mIngredients[mChosenIngredient].mEntityType == type;
                  });
 
-    return inventoryMaterials;
+    return Span<Entity *>(inventoryMaterials);
 }
 
 bool CraftingScreen::currentRecipeSatisfied() {
@@ -146,6 +148,7 @@ void CraftingScreen::buildItem(Point pos) {
     }
 
     NotificationMessageRenderer::getInstance().queueMessage("Created " + recipe->mNameOfProduct);
+    EventBus::getInstance().publish(CraftEvent{recipe->mNameOfProduct});
 }
 
 void CraftingScreen::enable() {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../Arena.h"
 #include "../../Point.h"
 #include "../../Recipe/Recipe.h"
 #include "../States/CraftingScreenState/ChoosingRecipeCraftingScreenState.h"
@@ -11,7 +12,7 @@ struct PlayerEntity;
 struct CraftingScreen : Screen {
     explicit CraftingScreen(PlayerEntity &player) : Screen(false), mPlayer(player) {}
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
 
     /// Render crafting screen
     /// \param font Font object to render using
@@ -40,8 +41,8 @@ struct CraftingScreen : Screen {
 
     /// Filter inventory items for items that are of the currently chosen material type and are not in
     /// currentlyChosenMaterials
-    /// \return vector of shared pointers to the inventory items as described above
-    std::vector<Entity *> filterInventoryForChosenMaterials();
+    /// \return pointers to the inventory items as described above, in the calling thread's frame arena
+    Span<Entity *> filterInventoryForChosenMaterials();
     bool currentRecipeSatisfied();
     void buildItem(Point pos);
 
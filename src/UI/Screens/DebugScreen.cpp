@@ -9,7 +9,7 @@ DebugScreen::DebugScreen() : Screen(false) {
     mState->onEntry(*this);
 }
 
-void DebugScreen::handleInput(SDL_KeyboardEvent &e) {
+void DebugScreen::handleInput(KeyEvent &e) {
     auto newState = mState->handleInput(*this, e);
     if (newState != nullptr) {
         mState->onExit(*this);
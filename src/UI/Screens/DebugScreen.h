@@ -8,14 +8,14 @@
 struct DebugScreen : Screen {
     DebugScreen();
 
-    const std::vector<std::string> cDebugOptions = {"1) Change time of day"};
+    const std::vector<std::string> cDebugOptions = {"1) Change time of day", "2) Toggle performance overlay"};
 
     void enable() override {
         mChoosingDebugAction = false;
         Screen::enable();
     }
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
     void render(Font &font) override;
 
     void setChoosingDebugAction(bool choosingDebugAction);
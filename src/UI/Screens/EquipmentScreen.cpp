@@ -7,7 +7,7 @@
 #include "../../Property/Properties/MeleeWeaponDamageProperty.h"
 #include "../MessageBoxRenderer.h"
 
-void EquipmentScreen::handleInput(SDL_KeyboardEvent &e) {
+void EquipmentScreen::handleInput(KeyEvent &e) {
     // TODO: this repeated code should be abstracted out
     auto newState = mState->handleInput(*this, e);
     if (newState != nullptr) {
@@ -9,7 +9,7 @@ struct PlayerEntity;
 struct EquipmentScreen : Screen {
     explicit EquipmentScreen(PlayerEntity &player) : Screen(false), mPlayer(player) {}
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
 
     /// Render equipment screen
     /// \param font Font object to render using
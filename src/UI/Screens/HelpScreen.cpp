@@ -1,8 +1,8 @@
 #include "HelpScreen.h"
 #include "../../Font.h"
 
-void HelpScreen::handleInput(SDL_KeyboardEvent &e) {
-    if (e.key == SDLK_ESCAPE || (e.key == SDLK_SLASH && e.mod & SDL_KMOD_SHIFT))
+void HelpScreen::handleInput(KeyEvent &e) {
+    if (e.mKey == KEY_ESCAPE || (e.mKey == KEY_SLASH && e.mMod & KEYMOD_SHIFT))
         disable();
 }
 
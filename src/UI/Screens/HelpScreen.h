@@ -2,6 +2,7 @@
 
 #include "Screen.h"
 
+#include <string>
 #include <vector>
 
 struct HelpScreen : Screen {
@@ -20,6 +21,6 @@ struct HelpScreen : Screen {
                                                     "Interact: space",
                                                     "This screen: ?"};
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
     void render(Font &font) override;
 };
@@ -6,7 +6,9 @@
 #include "../../utils.h"
 #include "../MessageBoxRenderer.h"
 
-void InspectionDialog::handleInput(SDL_KeyboardEvent &e) {
+#include <algorithm>
+
+void InspectionDialog::handleInput(KeyEvent &e) {
     auto newState = mState->handleInput(*this, e);
     if (newState != nullptr) {
         mState->onExit(*this);
@@ -18,7 +20,8 @@ void InspectionDialog::handleInput(SDL_KeyboardEvent &e) {
 }
 
 void InspectionDialog::render(Font &font) {
-    const auto &entitiesAtPointBefore = EntityManager::getInstance().getEntitiesAtPosFaster(mChosenPoint);
+    const auto &entitiesAtPointBefore =
+        EntityManager::getInstance().getEntitiesAtPosFaster(mChosenPoint, Arena::getFrameArena());
     std::vector<Entity *> entitiesAtPoint;
 
     std::copy_if(entitiesAtPointBefore.cbegin(), entitiesAtPointBefore.cend(), std::back_inserter(entitiesAtPoint),
@@ -9,7 +9,7 @@ struct PlayerEntity;
 struct InspectionDialog : Screen {
     explicit InspectionDialog(PlayerEntity &player) : Screen(true), mPlayer(player) {}
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
     void render(Font &font) override;
 
     void enableAtPoint(Point initialPoint) {
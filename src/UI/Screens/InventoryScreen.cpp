@@ -4,7 +4,7 @@
 #include "../../Font.h"
 #include "../../World.h"
 
-void InventoryScreen::handleInput(SDL_KeyboardEvent &e) {
+void InventoryScreen::handleInput(KeyEvent &e) {
     auto newState = mState->handleInput(*this, e);
     if (newState != nullptr) {
         mState->onExit(*this);
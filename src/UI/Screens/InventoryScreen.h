@@ -13,7 +13,7 @@ struct InventoryScreen : Screen {
 
     explicit InventoryScreen(PlayerEntity &player) : Screen(false), mPlayer(player) {}
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
     void render(Font &font) override;
 
     void enable() override {
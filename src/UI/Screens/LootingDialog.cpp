@@ -18,7 +18,7 @@ void LootingDialog::showItemsToLoot(std::vector<Entity *> items, Entity *entityT
     mEnabled = true;
 }
 
-void LootingDialog::handleInput(SDL_KeyboardEvent &e) {
+void LootingDialog::handleInput(KeyEvent &e) {
     auto newState = mState->handleInput(*this, e);
     if (newState != nullptr) {
         mState->onExit(*this);
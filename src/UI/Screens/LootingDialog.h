@@ -14,7 +14,7 @@ struct LootingDialog : Screen {
     void showItemsToLoot(std::vector<Entity *> items);
     void showItemsToLoot(std::vector<Entity *> items, Entity *entityToTransferFrom);
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
     void render(Font &font) override;
 
     void setViewingDescription(bool viewingDescription);
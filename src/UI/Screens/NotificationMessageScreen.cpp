@@ -3,10 +3,10 @@
 #include "../../Font.h"
 #include "../NotificationMessageRenderer.h"
 
-void NotificationMessageScreen::handleInput(SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
-    case SDLK_M:
+void NotificationMessageScreen::handleInput(KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
+    case KEY_M:
         mEnabled = false;
         break;
     }
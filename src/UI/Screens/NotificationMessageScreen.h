@@ -5,6 +5,6 @@
 struct NotificationMessageScreen : Screen {
     NotificationMessageScreen() : Screen(false) {}
 
-    void handleInput(SDL_KeyboardEvent &e) override;
+    void handleInput(KeyEvent &e) override;
     void render(Font &font) override;
 };
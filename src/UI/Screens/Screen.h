@@ -1,6 +1,6 @@
 #pragma once
 
-#include <SDL3/SDL_events.h>
+#include "../../KeyEvent.h"
 
 class Font;
 struct Entity;
@@ -18,7 +18,7 @@ struct Screen {
     virtual void disable() { mEnabled = false; }
     bool isEnabled() const { return mEnabled; }
     bool shouldRenderWorld() const { return mShouldRenderWorld; }
-    virtual void handleInput(SDL_KeyboardEvent &e) = 0;
+    virtual void handleInput(KeyEvent &e) = 0;
     virtual void render(Font &font) = 0;
 
   protected:
@@ -7,7 +7,7 @@
 
 void ChoosingBuildPositionCraftingScreenState::tryToBuildAtPosition(CraftingScreen &screen, Point posOffset) {
     auto p = posOffset + screen.getPlayer().getPos();
-    if (EntityManager::getInstance().getEntitiesAtPosFaster(p).empty()) {
+    if (EntityManager::getInstance().getEntitiesAtPosFaster(p, Arena::getFrameArena()).empty()) {
         mHaveChosenPositionInWorld = true;
         screen.buildItem(p);
     } else {
@@ -20,30 +20,30 @@ void ChoosingBuildPositionCraftingScreenState::onEntry(CraftingScreen &screen) {
 }
 
 std::unique_ptr<CraftingScreenState> ChoosingBuildPositionCraftingScreenState::handleInput(CraftingScreen &screen,
-                                                                                           SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_J:
+                                                                                           KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_J:
         tryToBuildAtPosition(screen, Point{0, 1});
         break;
-    case SDLK_K:
+    case KEY_K:
         tryToBuildAtPosition(screen, Point{0, -1});
         break;
-    case SDLK_L:
+    case KEY_L:
         tryToBuildAtPosition(screen, Point{1, 0});
         break;
-    case SDLK_H:
+    case KEY_H:
         tryToBuildAtPosition(screen, Point{-1, 0});
         break;
-    case SDLK_Y:
+    case KEY_Y:
         tryToBuildAtPosition(screen, Point{-1, -1});
         break;
-    case SDLK_U:
+    case KEY_U:
         tryToBuildAtPosition(screen, Point{1, -1});
         break;
-    case SDLK_B:
+    case KEY_B:
         tryToBuildAtPosition(screen, Point{-1, 1});
         break;
-    case SDLK_N:
+    case KEY_N:
         tryToBuildAtPosition(screen, Point{1, 1});
         break;
     }
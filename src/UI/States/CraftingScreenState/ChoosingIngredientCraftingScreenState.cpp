@@ -12,14 +12,14 @@ void ChoosingIngredientCraftingScreenState::onEntry(CraftingScreen &screen) {
 }
 
 std::unique_ptr<CraftingScreenState> ChoosingIngredientCraftingScreenState::handleInput(CraftingScreen &screen,
-                                                                                        SDL_KeyboardEvent &e) {
+                                                                                        KeyEvent &e) {
     auto &rm = RecipeManager::getInstance();
-    switch (e.key) {
-    case SDLK_ESCAPE:
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.reset();
         screen.disable();
         break;
-    case SDLK_J:
+    case KEY_J:
         if ((size_t)mChosenIngredient == rm.mRecipes[screen.getChosenRecipe()]->mIngredients.size())
             mChosenIngredient = 0;
         else
@@ -27,7 +27,7 @@ std::unique_ptr<CraftingScreenState> ChoosingIngredientCraftingScreenState::hand
         screen.setChosenIngredient(mChosenIngredient);
         screen.setChosenMaterial(0);
         break;
-    case SDLK_K:
+    case KEY_K:
         if (mChosenIngredient == 0)
             mChosenIngredient = (int)rm.mRecipes[screen.getChosenRecipe()]->mIngredients.size();
         else
@@ -35,8 +35,8 @@ std::unique_ptr<CraftingScreenState> ChoosingIngredientCraftingScreenState::hand
         screen.setChosenIngredient(mChosenIngredient);
         screen.setChosenMaterial(0);
         break;
-    case SDLK_L:
-    case SDLK_RETURN: {
+    case KEY_L:
+    case KEY_RETURN: {
         auto &currentRecipe = screen.getCurrentRecipe();
         if ((size_t)mChosenIngredient == currentRecipe->mIngredients.size()) {
             if (screen.currentRecipeSatisfied()) {
@@ -55,8 +55,8 @@ std::unique_ptr<CraftingScreenState> ChoosingIngredientCraftingScreenState::hand
             return std::make_unique<ChoosingMaterialCraftingScreenState>();
         break;
     }
-    case SDLK_H:
-    case SDLK_BACKSPACE:
+    case KEY_H:
+    case KEY_BACKSPACE:
         screen.setChosenMaterial(0);
         //            mLayer = CraftingLayer::RECIPE;
         screen.getCurrentRecipe().release(); // NOLINT(bugprone-unused-return-value)
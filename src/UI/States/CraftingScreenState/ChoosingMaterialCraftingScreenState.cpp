@@ -9,13 +9,13 @@ void ChoosingMaterialCraftingScreenState::onEntry(CraftingScreen &screen) {
 }
 
 std::unique_ptr<CraftingScreenState> ChoosingMaterialCraftingScreenState::handleInput(CraftingScreen &screen,
-                                                                                      SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+                                                                                      KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.reset();
         screen.disable();
         break;
-    case SDLK_J: {
+    case KEY_J: {
         auto inventoryMaterials = screen.filterInventoryForChosenMaterials();
         if ((size_t)mChosenMaterial == inventoryMaterials.size() - 1)
             mChosenMaterial = 0;
@@ -24,7 +24,7 @@ std::unique_ptr<CraftingScreenState> ChoosingMaterialCraftingScreenState::handle
         screen.setChosenMaterial(mChosenMaterial);
         break;
     }
-    case SDLK_K: {
+    case KEY_K: {
         auto inventoryMaterials = screen.filterInventoryForChosenMaterials();
         if (mChosenMaterial == 0)
             mChosenMaterial = (int)inventoryMaterials.size() - 1;
@@ -33,8 +33,8 @@ std::unique_ptr<CraftingScreenState> ChoosingMaterialCraftingScreenState::handle
         screen.setChosenMaterial(mChosenMaterial);
         break;
     }
-    case SDLK_L:
-    case SDLK_RETURN: {
+    case KEY_L:
+    case KEY_RETURN: {
         auto inventoryMaterials = screen.filterInventoryForChosenMaterials();
         auto &currentRecipe = screen.getCurrentRecipe();
         auto chosenIngredient = screen.getChosenIngredient();
@@ -56,8 +56,8 @@ std::unique_ptr<CraftingScreenState> ChoosingMaterialCraftingScreenState::handle
         }
         break;
     }
-    case SDLK_H:
-    case SDLK_BACKSPACE:
+    case KEY_H:
+    case KEY_BACKSPACE:
         screen.setChosenMaterial(0);
         return std::make_unique<ChoosingIngredientCraftingScreenState>();
     }
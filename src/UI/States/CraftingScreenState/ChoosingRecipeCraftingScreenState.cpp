@@ -10,14 +10,14 @@ void ChoosingRecipeCraftingScreenState::onEntry(CraftingScreen &screen) {
 }
 
 std::unique_ptr<CraftingScreenState> ChoosingRecipeCraftingScreenState::handleInput(CraftingScreen &screen,
-                                                                                    SDL_KeyboardEvent &e) {
+                                                                                    KeyEvent &e) {
     auto &rm = RecipeManager::getInstance();
 
-    switch (e.key) {
-    case SDLK_ESCAPE:
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.disable();
         return nullptr;
-    case SDLK_J:
+    case KEY_J:
         if ((size_t)mChosenRecipe == rm.mRecipes.size() - 1)
             mChosenRecipe = 0;
         else
@@ -27,7 +27,7 @@ std::unique_ptr<CraftingScreenState> ChoosingRecipeCraftingScreenState::handleIn
         screen.setChosenMaterial(0);
         screen.setChosenRecipe(mChosenRecipe);
         break;
-    case SDLK_K:
+    case KEY_K:
         if (mChosenRecipe == 0)
             mChosenRecipe = (int)rm.mRecipes.size() - 1;
         else
@@ -37,8 +37,8 @@ std::unique_ptr<CraftingScreenState> ChoosingRecipeCraftingScreenState::handleIn
         screen.setChosenMaterial(0);
         screen.setChosenRecipe(mChosenRecipe);
         break;
-    case SDLK_L:
-    case SDLK_RETURN:
+    case KEY_L:
+    case KEY_RETURN:
         screen.setCurrentRecipe(std::make_unique<Recipe>(Recipe(*rm.mRecipes[mChosenRecipe])));
         return std::make_unique<ChoosingIngredientCraftingScreenState>();
     }
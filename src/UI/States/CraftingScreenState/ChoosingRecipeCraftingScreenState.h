@@ -4,7 +4,7 @@
 class ChoosingRecipeCraftingScreenState : public CraftingScreenState {
   public:
     void onEntry(CraftingScreen &screen) override;
-    std::unique_ptr<CraftingScreenState> handleInput(CraftingScreen &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<CraftingScreenState> handleInput(CraftingScreen &screen, KeyEvent &e) override;
     void onExit(CraftingScreen & /*screen*/) override {};
 
   private:
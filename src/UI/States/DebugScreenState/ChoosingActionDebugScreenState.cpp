@@ -1,18 +1,23 @@
 #include "ChoosingActionDebugScreenState.h"
 
+#include "../../../PerformanceStats.h"
 #include "../../Screens/DebugScreen.h"
 #include "ChoosingTimeOfDayDebugScreenState.h"
 
 void ChoosingActionDebugScreenState::onEntry(DebugScreen &screen) { screen.setChoosingDebugAction(true); }
 
-std::unique_ptr<DebugScreenState> ChoosingActionDebugScreenState::handleInput(DebugScreen &screen,
-                                                                              SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+std::unique_ptr<DebugScreenState> ChoosingActionDebugScreenState::handleInput(DebugScreen &screen, KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.disable();
         return nullptr;
-    case SDLK_1:
+    case KEY_1:
         return std::make_unique<ChoosingTimeOfDayDebugScreenState>();
+    case KEY_2: {
+        auto &stats = PerformanceStats::getInstance();
+        stats.setOverlayEnabled(!stats.isOverlayEnabled());
+        return nullptr;
+    }
     }
 
     return nullptr;
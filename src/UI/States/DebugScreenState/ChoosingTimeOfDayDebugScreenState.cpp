@@ -10,11 +10,10 @@ void ChoosingTimeOfDayDebugScreenState::onEntry(DebugScreen &screen) {
     screen.setChosenTime(mChosenTime);
 }
 
-std::unique_ptr<DebugScreenState> ChoosingTimeOfDayDebugScreenState::handleInput(DebugScreen &screen,
-                                                                                 SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_UP:
-    case SDLK_K:
+std::unique_ptr<DebugScreenState> ChoosingTimeOfDayDebugScreenState::handleInput(DebugScreen &screen, KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_UP:
+    case KEY_K:
         switch (mStringPos) {
         case 0:
             mChosenTime += Time(10, 0);
@@ -31,8 +30,8 @@ std::unique_ptr<DebugScreenState> ChoosingTimeOfDayDebugScreenState::handleInput
         }
         screen.setChosenTime(mChosenTime);
         break;
-    case SDLK_DOWN:
-    case SDLK_J:
+    case KEY_DOWN:
+    case KEY_J:
         switch (mStringPos) {
         case 0:
             mChosenTime -= Time(10, 0);
@@ -49,23 +48,23 @@ std::unique_ptr<DebugScreenState> ChoosingTimeOfDayDebugScreenState::handleInput
         }
         screen.setChosenTime(mChosenTime);
         break;
-    case SDLK_LEFT:
-    case SDLK_H:
+    case KEY_LEFT:
+    case KEY_H:
         --mStringPos;
         if (mStringPos < 0)
             mStringPos = 3;
         screen.setStringPos(mStringPos);
         break;
-    case SDLK_RIGHT:
-    case SDLK_L:
+    case KEY_RIGHT:
+    case KEY_L:
         ++mStringPos;
         if (mStringPos > 3)
             mStringPos = 0;
         screen.setStringPos(mStringPos);
         break;
-    case SDLK_ESCAPE:
+    case KEY_ESCAPE:
         return std::make_unique<ChoosingActionDebugScreenState>();
-    case SDLK_RETURN:
+    case KEY_RETURN:
         EntityManager::getInstance().setTimeOfDay(mChosenTime);
         return std::make_unique<ChoosingActionDebugScreenState>();
     }
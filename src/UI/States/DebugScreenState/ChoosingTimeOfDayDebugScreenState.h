@@ -6,7 +6,7 @@
 class ChoosingTimeOfDayDebugScreenState : public DebugScreenState {
   public:
     void onEntry(DebugScreen &screen) override;
-    std::unique_ptr<DebugScreenState> handleInput(DebugScreen &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<DebugScreenState> handleInput(DebugScreen &screen, KeyEvent &e) override;
     void onExit(DebugScreen &screen) override;
 
   private:
@@ -8,11 +8,11 @@
 void ChoosingActionEquipmentScreenState::onEntry(EquipmentScreen &screen) { screen.setChoosingEquipmentAction(true); }
 
 std::unique_ptr<EquipmentScreenState> ChoosingActionEquipmentScreenState::handleInput(EquipmentScreen &screen,
-                                                                                      SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+                                                                                      KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         return std::make_unique<ChoosingSlotEquipmentScreenState>();
-    case SDLK_RETURN: {
+    case KEY_RETURN: {
         auto &player = screen.getPlayer();
         auto chosenSlot = screen.getChosenSlot();
         if (player.hasEquippedInSlot(chosenSlot)) {
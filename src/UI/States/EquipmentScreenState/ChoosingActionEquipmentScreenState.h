@@ -5,6 +5,6 @@
 class ChoosingActionEquipmentScreenState : public EquipmentScreenState {
   public:
     void onEntry(EquipmentScreen &screen) override;
-    std::unique_ptr<EquipmentScreenState> handleInput(EquipmentScreen &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<EquipmentScreenState> handleInput(EquipmentScreen &screen, KeyEvent &e) override;
     void onExit(EquipmentScreen &screen) override;
 };
@@ -7,11 +7,11 @@
 void ChoosingNewEquipmentScreenState::onEntry(EquipmentScreen &screen) { screen.setChoosingNewEquipment(true); }
 
 std::unique_ptr<EquipmentScreenState> ChoosingNewEquipmentScreenState::handleInput(EquipmentScreen &screen,
-                                                                                   SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+                                                                                   KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         return std::make_unique<ChoosingSlotEquipmentScreenState>();
-    case SDLK_J: {
+    case KEY_J: {
         auto equippableIDs = screen.getPlayer().getInventoryItemsEquippableInSlot(screen.getChosenSlot());
         if ((size_t)mChoosingNewEquipmentIndex == equippableIDs.size() - 1)
             mChoosingNewEquipmentIndex = 0;
@@ -20,7 +20,7 @@ std::unique_ptr<EquipmentScreenState> ChoosingNewEquipmentScreenState::handleInp
         screen.setChoosingNewEquipmentIndex(mChoosingNewEquipmentIndex);
         break;
     }
-    case SDLK_K: {
+    case KEY_K: {
         auto equippableIDs = screen.getPlayer().getInventoryItemsEquippableInSlot(screen.getChosenSlot());
         if (mChoosingNewEquipmentIndex == 0)
             mChoosingNewEquipmentIndex = static_cast<int>(equippableIDs.size()) - 1;
@@ -29,7 +29,7 @@ std::unique_ptr<EquipmentScreenState> ChoosingNewEquipmentScreenState::handleInp
         screen.setChoosingNewEquipmentIndex(mChoosingNewEquipmentIndex);
         break;
     }
-    case SDLK_RETURN: {
+    case KEY_RETURN: {
         auto &player = screen.getPlayer();
         auto chosenSlot = screen.getChosenSlot();
         auto equippableIDs = player.getInventoryItemsEquippableInSlot(chosenSlot);
@@ -8,21 +8,21 @@
 void ChoosingSlotEquipmentScreenState::onEntry(EquipmentScreen &screen) { mChosenSlot = screen.getChosenSlot(); }
 
 std::unique_ptr<EquipmentScreenState> ChoosingSlotEquipmentScreenState::handleInput(EquipmentScreen &screen,
-                                                                                    SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+                                                                                    KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.reset();
         screen.disable();
         break;
-    case SDLK_J:
+    case KEY_J:
         ++mChosenSlot;
         screen.setChosenSlot(mChosenSlot);
         break;
-    case SDLK_K:
+    case KEY_K:
         --mChosenSlot;
         screen.setChosenSlot(mChosenSlot);
         break;
-    case SDLK_RETURN:
+    case KEY_RETURN:
         auto &player = screen.getPlayer();
         if (!player.hasEquippedInSlot(mChosenSlot) && !player.getInventoryItemsEquippableInSlot(mChosenSlot).empty())
             return std::make_unique<ChoosingNewEquipmentScreenState>();
@@ -9,42 +9,43 @@
 void ChoosingPositionInspectionDialogState::onEntry(InspectionDialog & /*screen*/) {}
 
 std::unique_ptr<InspectionDialogState> ChoosingPositionInspectionDialogState::handleInput(InspectionDialog &screen,
-                                                                                          SDL_KeyboardEvent &e) {
+                                                                                          KeyEvent &e) {
     mChosenPoint = screen.getChosenPoint();
 
     Point posOffset;
 
-    switch (e.key) {
-    case SDLK_ESCAPE:
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.disable();
         return nullptr;
-    case SDLK_H:
+    case KEY_H:
         posOffset = Point(-1, 0);
         break;
-    case SDLK_J:
+    case KEY_J:
         posOffset = Point(0, 1);
         break;
-    case SDLK_K:
+    case KEY_K:
         posOffset = Point(0, -1);
         break;
-    case SDLK_L:
+    case KEY_L:
         posOffset = Point(1, 0);
         break;
-    case SDLK_Y:
+    case KEY_Y:
         posOffset = Point(-1, -1);
         break;
-    case SDLK_U:
+    case KEY_U:
         posOffset = Point(1, -1);
         break;
-    case SDLK_B:
+    case KEY_B:
         posOffset = Point(-1, 1);
         break;
-    case SDLK_N:
+    case KEY_N:
         posOffset = Point(1, 1);
         break;
-    case SDLK_EQUALS:
+    case KEY_EQUALS:
         if (screen.isSelectingFromMultipleOptions()) {
-            const auto &currentEntities = EntityManager::getInstance().getEntitiesAtPosFaster(mChosenPoint);
+            const auto &currentEntities =
+                EntityManager::getInstance().getEntitiesAtPosFaster(mChosenPoint, Arena::getFrameArena());
             if ((size_t)mChosenIndex == currentEntities.size() - 1)
                 mChosenIndex = 0;
             else
@@ -52,9 +53,10 @@ std::unique_ptr<InspectionDialogState> ChoosingPositionInspectionDialogState::ha
             screen.setChosenIndex(mChosenIndex);
         }
         break;
-    case SDLK_MINUS:
+    case KEY_MINUS:
         if (screen.isSelectingFromMultipleOptions()) {
-            const auto &currentEntities = EntityManager::getInstance().getEntitiesAtPosFaster(mChosenPoint);
+            const auto &currentEntities =
+                EntityManager::getInstance().getEntitiesAtPosFaster(mChosenPoint, Arena::getFrameArena());
             if (mChosenIndex == 0)
                 mChosenIndex = (int)(currentEntities.size() - 1);
             else
@@ -62,13 +64,13 @@ std::unique_ptr<InspectionDialogState> ChoosingPositionInspectionDialogState::ha
             screen.setChosenIndex(mChosenIndex);
         }
         break;
-    case SDLK_RETURN:
+    case KEY_RETURN:
         if (screen.isThereAnEntity())
             return std::make_unique<ViewingDescriptionInspectionDialogState>();
         break;
     }
 
-    if (e.mod & SDL_KMOD_SHIFT) // NOLINT(hicpp-signed-bitwise)
+    if (e.mMod & KEYMOD_SHIFT) // NOLINT(hicpp-signed-bitwise)
         posOffset *= 5;
 
     mChosenPoint = clipToScreenEdge(screen, mChosenPoint + posOffset);
@@ -5,7 +5,7 @@
 class ChoosingPositionInspectionDialogState : public InspectionDialogState {
   public:
     void onEntry(InspectionDialog &screen) override;
-    std::unique_ptr<InspectionDialogState> handleInput(InspectionDialog &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<InspectionDialogState> handleInput(InspectionDialog &screen, KeyEvent &e) override;
     void onExit(InspectionDialog &screen) override;
 
   private:
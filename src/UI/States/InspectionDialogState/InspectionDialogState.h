@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../UIStateMacro.h"
-#include <SDL3/SDL_events.h>
+#include "../../../KeyEvent.h"
 #include <memory>
 
 struct InspectionDialog;
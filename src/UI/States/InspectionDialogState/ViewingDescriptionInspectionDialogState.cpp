@@ -6,9 +6,9 @@
 void ViewingDescriptionInspectionDialogState::onEntry(InspectionDialog &screen) { screen.setViewingDescription(true); }
 
 std::unique_ptr<InspectionDialogState>
-ViewingDescriptionInspectionDialogState::handleInput(InspectionDialog & /*screen*/, SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+ViewingDescriptionInspectionDialogState::handleInput(InspectionDialog & /*screen*/, KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         return std::make_unique<ChoosingPositionInspectionDialogState>();
     }
 
@@ -6,9 +6,9 @@
 void ViewingDescriptionInventoryState::onEntry(InventoryScreen &screen) { screen.setViewingDescription(true); }
 
 std::unique_ptr<InventoryScreenState> ViewingDescriptionInventoryState::handleInput(InventoryScreen & /*screen*/,
-                                                                                    SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+                                                                                    KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         return std::make_unique<ViewingInventoryState>();
     }
 
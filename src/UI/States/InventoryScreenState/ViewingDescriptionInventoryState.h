@@ -5,6 +5,6 @@
 class ViewingDescriptionInventoryState : public InventoryScreenState {
   public:
     void onEntry(InventoryScreen &screen) override;
-    std::unique_ptr<InventoryScreenState> handleInput(InventoryScreen &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<InventoryScreenState> handleInput(InventoryScreen &screen, KeyEvent &e) override;
     void onExit(InventoryScreen &screen) override;
 };
\ No newline at end of file
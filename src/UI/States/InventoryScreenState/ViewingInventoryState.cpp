@@ -7,17 +7,16 @@
 
 void ViewingInventoryState::onEntry(InventoryScreen & /*screen*/) {}
 
-std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(InventoryScreen &screen,
-                                                                         SDL_KeyboardEvent &e) {
+std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(InventoryScreen &screen, KeyEvent &e) {
     auto &player = screen.getPlayer();
 
     mChosenIndex = screen.getChosenIndex();
 
-    switch (e.key) {
-    case SDLK_ESCAPE:
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.disable();
         break;
-    case SDLK_J:
+    case KEY_J:
         if (!player.isInventoryEmpty()) {
             if ((size_t)mChosenIndex < (player.getInventorySize() - 1))
                 mChosenIndex++;
@@ -26,7 +25,7 @@ std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(Invento
         }
         screen.setChosenIndex(mChosenIndex);
         break;
-    case SDLK_K:
+    case KEY_K:
         if (!player.isInventoryEmpty()) {
             if (mChosenIndex > 0)
                 mChosenIndex--;
@@ -35,7 +34,7 @@ std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(Invento
         }
         screen.setChosenIndex(mChosenIndex);
         break;
-    case SDLK_D:
+    case KEY_D:
         if (!player.isInventoryEmpty()) {
             auto itemID = player.getInventoryItemID(mChosenIndex);
             if (player.hasEquipped(itemID))
@@ -49,7 +48,7 @@ std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(Invento
             }
         }
         break;
-    case SDLK_E:
+    case KEY_E:
         if (!player.isInventoryEmpty()) {
             auto item = player.getInventoryItem(mChosenIndex);
             auto eatable = item->getProperty<EatableProperty>();
@@ -64,7 +63,7 @@ std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(Invento
             }
         }
         break;
-    case SDLK_A:
+    case KEY_A:
         if (!player.isInventoryEmpty()) {
             auto item = player.getInventoryItem(mChosenIndex);
             if (item->hasBehaviour("ApplyableBehaviour")) {
@@ -76,7 +75,7 @@ std::unique_ptr<InventoryScreenState> ViewingInventoryState::handleInput(Invento
             }
         }
         break;
-    case SDLK_RETURN:
+    case KEY_RETURN:
         if (!player.isInventoryEmpty())
             return std::make_unique<ViewingDescriptionInventoryState>();
         break;
@@ -5,7 +5,7 @@
 class ViewingInventoryState : public InventoryScreenState {
   public:
     void onEntry(InventoryScreen &screen) override;
-    std::unique_ptr<InventoryScreenState> handleInput(InventoryScreen &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<InventoryScreenState> handleInput(InventoryScreen &screen, KeyEvent &e) override;
     void onExit(InventoryScreen &screen) override;
 
   private:
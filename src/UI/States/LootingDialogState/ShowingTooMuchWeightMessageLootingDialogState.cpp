@@ -8,10 +8,10 @@ void ShowingTooMuchWeightMessageLootingDialogState::onEntry(LootingDialog &scree
 }
 
 std::unique_ptr<LootingDialogState>
-ShowingTooMuchWeightMessageLootingDialogState::handleInput(LootingDialog & /*screen*/, SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_RETURN:
-    case SDLK_ESCAPE:
+ShowingTooMuchWeightMessageLootingDialogState::handleInput(LootingDialog & /*screen*/, KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_RETURN:
+    case KEY_ESCAPE:
         return std::make_unique<ViewingLootingDialogState>();
     }
 
@@ -6,9 +6,9 @@
 void ViewingDescriptionLootingDialogState::onEntry(LootingDialog &screen) { screen.setViewingDescription(true); }
 
 std::unique_ptr<LootingDialogState> ViewingDescriptionLootingDialogState::handleInput(LootingDialog & /*screen*/,
-                                                                                      SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+                                                                                      KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         return std::make_unique<ViewingLootingDialogState>();
     }
 
@@ -4,6 +4,6 @@
 class ViewingDescriptionLootingDialogState : public LootingDialogState {
   public:
     void onEntry(LootingDialog &screen) override;
-    std::unique_ptr<LootingDialogState> handleInput(LootingDialog &screen, SDL_KeyboardEvent &e) override;
+    std::unique_ptr<LootingDialogState> handleInput(LootingDialog &screen, KeyEvent &e) override;
     void onExit(LootingDialog &screen) override;
 };
@@ -7,15 +7,14 @@
 
 void ViewingLootingDialogState::onEntry(LootingDialog &screen) { mChosenIndex = screen.getChosenIndex(); }
 
-std::unique_ptr<LootingDialogState> ViewingLootingDialogState::handleInput(LootingDialog &screen,
-                                                                           SDL_KeyboardEvent &e) {
-    switch (e.key) {
-    case SDLK_ESCAPE:
+std::unique_ptr<LootingDialogState> ViewingLootingDialogState::handleInput(LootingDialog &screen, KeyEvent &e) {
+    switch (e.mKey) {
+    case KEY_ESCAPE:
         screen.disable();
         break;
-    case SDLK_RETURN:
+    case KEY_RETURN:
         return std::make_unique<ViewingDescriptionLootingDialogState>();
-    case SDLK_J:
+    case KEY_J:
         if (!screen.getItemsToShow().empty()) {
             if ((size_t)mChosenIndex < (screen.getItemsToShow().size() - 1))
                 mChosenIndex++;
@@ -24,7 +23,7 @@ std::unique_ptr<LootingDialogState> ViewingLootingDialogState::handleInput(Looti
             screen.setChosenIndex(mChosenIndex);
         }
         break;
-    case SDLK_K:
+    case KEY_K:
         if (!screen.getItemsToShow().empty()) {
             if (mChosenIndex > 0)
                 mChosenIndex--;
@@ -33,7 +32,7 @@ std::unique_ptr<LootingDialogState> ViewingLootingDialogState::handleInput(Looti
             screen.setChosenIndex(mChosenIndex);
         }
         break;
-    case SDLK_G:
+    case KEY_G:
         auto &itemsToShow = screen.getItemsToShow();
         auto entityToTransferFrom = screen.getEntityToTransferFrom();
         if (screen.getPlayer().addToInventory(itemsToShow[mChosenIndex]->mID)) {
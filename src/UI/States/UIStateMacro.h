@@ -6,6 +6,6 @@
         virtual ~className() = default;                                                                                \
                                                                                                                        \
         virtual void onEntry(screenType &screen) = 0;                                                                  \
-        virtual std::unique_ptr<className> handleInput(screenType &screen, SDL_KeyboardEvent &e) = 0;                  \
+        virtual std::unique_ptr<className> handleInput(screenType &screen, KeyEvent &e) = 0;                           \
         virtual void onExit(screenType &screen) = 0;                                                                   \
     };
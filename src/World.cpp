@@ -1,4 +1,5 @@
 #include "World.h"
+#include "AllocationCounter.h"
 #include "Color.h"
 #include "Entity/BunnyHoleEntity.h"
 #include "Entity/Entity.h"
@@ -10,29 +11,46 @@
 #include "Entity/Sources/BushEntity.h"
 #include "Entity/Sources/GrassEntity.h"
 #include "Entity/WaterEntity.h"
+#include "FieldOfView.h"
 #include "Font.h"
-#include "utils.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "Random.h"
 
+#include <algorithm>
 #include <cmath>
 #include <unordered_set>
 
+const int World::SCREEN_WIDTH;
+const int World::SCREEN_HEIGHT;
+
 #define FOR_EACH_SCREEN_POINT                                                                                          \
     for (auto x = 0; x < World::SCREEN_WIDTH; ++x)                                                                     \
         for (auto y = 0; y < World::SCREEN_HEIGHT; ++y)
 
-void World::render(Font &font, int worldX, int worldY) { render(font, Point(worldX, worldY)); }
+void World::render(Font &font, int worldX, int worldY, const FieldOfView &fov) {
+    render(font, Point(worldX, worldY), fov);
+}
 
-void World::render(Font &font, const Point worldPos) {
+void World::render(Font &font, const Point worldPos, const FieldOfView &fov) {
     // If we haven't generated this screen, randomize this (and the screens around it)
     if (std::find(mGeneratedScreens.cbegin(), mGeneratedScreens.cend(), worldPos) == mGeneratedScreens.cend())
         randomizeScreensAround(worldPos);
 
     Color grey = Color::getColor("grassgreen");
-    FOR_EACH_SCREEN_POINT
-    font.draw(this->mFloor[worldPosToWorld(worldPos) + Point(x, y)], x, y, grey);
+    Color remembered = grey * 0.4f;
+    FOR_EACH_SCREEN_POINT {
+        auto p = worldPosToWorld(worldPos) + Point(x, y);
+        if (fov.isVisible(p))
+            font.draw(this->mFloor[p], x, y, grey);
+        else if (fov.hasSeen(p))
+            font.draw(this->mFloor[p], x, y, remembered);
+    }
 }
 
 void World::randomizeScreensAround(Point pos) {
+    PROFILE_ZONE("World::randomizeScreensAround");
+    ALLOCATION_ZONE("World::randomizeScreensAround");
     const std::vector<Point> pointsIncludingSurrounding{
         pos,
         pos + Point(-1, 0),
@@ -45,50 +63,59 @@ void World::randomizeScreensAround(Point pos) {
         pos + Point(1, 1),
     };
 
+    std::vector<ScreenPlan> plans;
     for (const auto &point : pointsIncludingSurrounding) {
         // if this screen has not already been generated, generate it
-        if (std::find(mGeneratedScreens.cbegin(), mGeneratedScreens.cend(), point) == mGeneratedScreens.cend())
-            randomizeScreen(point);
+        if (std::find(mGeneratedScreens.cbegin(), mGeneratedScreens.cend(), point) == mGeneratedScreens.cend()) {
+            plans.emplace_back();
+            plans.back().mWorldPos = point;
+        }
     }
+
+    JobSystem::getInstance().parallelFor(plans.size(), [&plans](size_t i) { planScreen(plans[i]); });
+
+    // Create the entities in a fixed order so that entity IDs do not depend on how the screens were scheduled
+    for (const auto &plan : plans)
+        applyScreenPlan(plan);
 }
 
 void World::randomizeScreen(Point worldPos) {
-    auto &manager = EntityManager::getInstance();
+    PROFILE_ZONE("World::randomizeScreen");
+    ScreenPlan plan;
+    plan.mWorldPos = worldPos;
+    planScreen(plan);
+    applyScreenPlan(plan);
+}
 
-    // keep track of the fact we've generated this screen
-    mGeneratedScreens.push_back(worldPos);
+void World::planScreen(ScreenPlan &plan) {
+    PROFILE_ZONE("World::planScreen");
+    // Each screen has its own stream, so its contents do not depend on which screens were generated before it
+    auto random = RandomStreams::getInstance().makeStream(
+        RandomStream::WORLD_GENERATION, std::to_string(plan.mWorldPos.mX) + "," + std::to_string(plan.mWorldPos.mY));
 
     // The top-left origin of the screen in world coordinates
-    Point p0 = worldPosToWorld(worldPos);
+    Point p0 = worldPosToWorld(plan.mWorldPos);
 
     // On first pass generate floor tiles
+    static const char floorGlyphs[] = {'`', '\'', '.', ','};
+    plan.mFloor.clear();
+    plan.mFloor.reserve(SCREEN_WIDTH * SCREEN_HEIGHT);
     FOR_EACH_SCREEN_POINT {
-        Point p = p0 + Point(x, y);
         // Generate background tile
-        switch (rand() % 4) {
-        case 0:
-            this->mFloor[p] = "`";
-            break;
-        case 1:
-            this->mFloor[p] = "'";
-            break;
-        case 2:
-            this->mFloor[p] = ".";
-            break;
-        case 3:
-            this->mFloor[p] = ",";
-            break;
-        }
+        plan.mFloor.push_back(floorGlyphs[random.nextBelow(4)]);
     }
 
     /// Generate random pools
-    const int numPools = rand() % 3;
+    const int numPools = static_cast<int>(random.nextBelow(3));
     std::vector<Point> poolOriginCoords;
     poolOriginCoords.reserve(numPools);
 
     // Choose random points from which to originate pools of water
-    for (int i = 0; i < numPools; ++i)
-        poolOriginCoords.emplace_back(p0 + Point(rand() % SCREEN_WIDTH, rand() % SCREEN_HEIGHT));
+    for (int i = 0; i < numPools; ++i) {
+        int x = static_cast<int>(random.nextBelow(SCREEN_WIDTH));
+        int y = static_cast<int>(random.nextBelow(SCREEN_HEIGHT));
+        poolOriginCoords.emplace_back(p0 + Point(x, y));
+    }
 
     // Set of tiles that will have water in (used set to avoid duplicates)
     std::unordered_set<Point> currentWaterTiles;
@@ -100,54 +127,83 @@ void World::randomizeScreen(Point worldPos) {
         Point p = p0 + Point(x, y);
 
         for (Point poolOrigin : poolOriginCoords)
-            if (randDouble() < std::exp(-std::pow(p.manhattanDistanceTo(poolOrigin) / 2.5, 2)))
+            if (random.nextDouble() < std::exp(-std::pow(p.manhattanDistanceTo(poolOrigin) / 2.5, 2)))
                 currentWaterTiles.emplace(p);
     }
 
     // Add all the generated water tiles as entities
-    for (Point p : currentWaterTiles) {
-        auto water = std::make_unique<WaterEntity>();
-        water->setPos(p);
-        manager.addEntity(std::move(water));
-    }
+    plan.mSpawns.clear();
+    for (Point p : currentWaterTiles)
+        plan.mSpawns.emplace_back(ScreenPlan::Spawn::WATER, p);
 
     /// Place other random entities
     FOR_EACH_SCREEN_POINT {
         Point p = p0 + Point(x, y);
         // Random chance of creating a bush
-        if (randDouble() < 0.002) {
-            auto bush = std::make_unique<BushEntity>();
-            bush->setPos(p);
-            manager.addEntity(std::move(bush));
-        }
+        if (random.nextDouble() < 0.002)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::BUSH, p);
         // Random chance of creating a twig
-        else if (randDouble() < 0.002) {
-            auto twig = std::make_unique<TwigEntity>();
-            twig->setPos(p);
-            manager.addEntity(std::move(twig));
-        }
+        else if (random.nextDouble() < 0.002)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::TWIG, p);
         // Random chance of creating grass
-        else if (randDouble() < 0.002) {
-            auto grass = std::make_unique<GrassEntity>();
-            grass->setPos(p);
-            manager.addEntity(std::move(grass));
-        } else if (randDouble() < 0.0005) {
-            auto bug = std::make_unique<GlowbugEntity>();
-            bug->setPos(p);
-            manager.addEntity(std::move(bug));
-        } else if (randDouble() < 0.0001) {
-            auto wolf = std::make_unique<WolfEntity>();
-            wolf->setPos(p);
-            manager.addEntity(std::move(wolf));
-        } else if (randDouble() < 0.001) {
-            auto bunny = std::make_unique<BunnyEntity>();
-            bunny->setPos(p);
-            manager.addEntity(std::move(bunny));
-        } else if (randDouble() < 0.001) {
-            auto hole = std::make_unique<BunnyHoleEntity>();
-            hole->setPos(p);
-            manager.addEntity(std::move(hole));
+        else if (random.nextDouble() < 0.002)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::GRASS, p);
+        else if (random.nextDouble() < 0.0005)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::GLOWBUG, p);
+        else if (random.nextDouble() < 0.0001)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::WOLF, p);
+        else if (random.nextDouble() < 0.001)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::BUNNY, p);
+        else if (random.nextDouble() < 0.001)
+            plan.mSpawns.emplace_back(ScreenPlan::Spawn::BUNNY_HOLE, p);
+    }
+}
+
+void World::applyScreenPlan(const ScreenPlan &plan) {
+    PROFILE_ZONE("World::applyScreenPlan");
+    auto &manager = EntityManager::getInstance();
+
+    // keep track of the fact we've generated this screen
+    mGeneratedScreens.push_back(plan.mWorldPos);
+
+    // The top-left origin of the screen in world coordinates
+    Point p0 = worldPosToWorld(plan.mWorldPos);
+
+    auto glyph = plan.mFloor.cbegin();
+    FOR_EACH_SCREEN_POINT {
+        this->mFloor[p0 + Point(x, y)] = std::string(1, *glyph++);
+    }
+
+    for (const auto &spawn : plan.mSpawns) {
+        std::unique_ptr<Entity> entity;
+        switch (spawn.first) {
+        case ScreenPlan::Spawn::WATER:
+            entity = std::make_unique<WaterEntity>();
+            break;
+        case ScreenPlan::Spawn::BUSH:
+            entity = std::make_unique<BushEntity>();
+            break;
+        case ScreenPlan::Spawn::TWIG:
+            entity = std::make_unique<TwigEntity>();
+            break;
+        case ScreenPlan::Spawn::GRASS:
+            entity = std::make_unique<GrassEntity>();
+            break;
+        case ScreenPlan::Spawn::GLOWBUG:
+            entity = std::make_unique<GlowbugEntity>();
+            break;
+        case ScreenPlan::Spawn::WOLF:
+            entity = std::make_unique<WolfEntity>();
+            break;
+        case ScreenPlan::Spawn::BUNNY:
+            entity = std::make_unique<BunnyEntity>();
+            break;
+        case ScreenPlan::Spawn::BUNNY_HOLE:
+            entity = std::make_unique<BunnyHoleEntity>();
+            break;
         }
+        entity->setPos(spawn.second);
+        manager.addEntity(std::move(entity));
     }
 }
 
@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <vector>
 
+class FieldOfView;
 class Font;
 /// This class handles the randomization and drawing of the floor tiles,
 /// as well as the random generation of all entities in the game
@@ -19,14 +20,16 @@ struct World {
     /// Each point in the world has a random floor tile glyph
     std::unordered_map<Point, std::string> mFloor;
 
-    void render(Font &font, int worldX, int worldY);
-    /// Render the floor tiles at the given world coordinates
+    void render(Font &font, int worldX, int worldY, const FieldOfView &fov);
+    /// Render the floor tiles at the given world coordinates. Tiles the player cannot see are dimmed if remembered and
+    /// not drawn otherwise
     /// \param font the font to render onto
     /// \param worldPos the coordinates on the world grid (each point is a screen)
-    void render(Font &font, Point worldPos);
+    /// \param fov the player's field of view
+    void render(Font &font, Point worldPos, const FieldOfView &fov);
 
     /// Randomize the screens in each of the eight directions around the screen given by the world coordinates
-    /// `worldPos` as well as the screen at `worldPos`
+    /// `worldPos` as well as the screen at `worldPos`. The screens are rolled in parallel on the JobSystem
     void randomizeScreensAround(Point worldPos);
 
     /// Randomize the floor tiles and generate entities for the screen at the world coordinates given by `worldPos`
@@ -39,6 +42,24 @@ struct World {
     static Point worldPosToWorld(Point worldPos);
 
   private:
+    /// The floor tiles and entities rolled for a screen. Rolling only reads the screen's own random stream, so screens
+    /// can be rolled in parallel, but entities have to be created one at a time as they register with the
+    /// EntityManager
+    struct ScreenPlan {
+        enum class Spawn { WATER, BUSH, TWIG, GRASS, GLOWBUG, WOLF, BUNNY, BUNNY_HOLE };
+
+        Point mWorldPos;
+        /// Floor glyph of every point on the screen, in FOR_EACH_SCREEN_POINT order
+        std::vector<char> mFloor;
+        /// Entities to create, in the order to create them
+        std::vector<std::pair<Spawn, Point>> mSpawns;
+    };
+
+    /// Roll the floor tiles and entities of the screen at plan.mWorldPos
+    static void planScreen(ScreenPlan &plan);
+    /// Set the floor tiles and create the entities that were rolled for a screen
+    void applyScreenPlan(const ScreenPlan &plan);
+
     /// Keep track of which screens we've generated already
     std::vector<Point> mGeneratedScreens;
 };
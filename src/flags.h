@@ -1,9 +0,0 @@
-
-#ifndef FLAGS_H_
-#define FLAGS_H_
-
-enum SIGNAL_FLAG {
-    SIGNAL_FORCE_WAIT = 1
-};
-
-#endif // FLAGS_H_
@@ -1,11 +1,85 @@
 #include "Game.h"
+#include "JobSystem.h"
+#include "Random.h"
 
 #define SDL_MAIN_USE_CALLBACKS 1
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <utility>
+
 SDL_AppResult SDL_AppInit(void **appstate_void, int argc, char *argv[]) {
-    auto *appstate = new Game();
+    auto worldSeed = static_cast<uint64_t>(std::time(nullptr));
+    std::string recordPath;
+    std::string replayPath;
+    GameOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        // Number of threads to run jobs on, besides the simulation and render threads which also help
+        if (arg == "--workers" && hasValue)
+            JobSystem::getInstance().setNumWorkers(static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10)));
+        // Seed for every random stream, so that a world can be played again
+        else if (arg == "--seed" && hasValue)
+            worldSeed = std::strtoull(argv[++i], nullptr, 10);
+        // Record the seed and every key handled to a file
+        else if (arg == "--record" && hasValue)
+            recordPath = argv[++i];
+        // Play back a recording, starting from its seed
+        else if (arg == "--replay" && hasValue)
+            replayPath = argv[++i];
+        // Play back as fast as possible
+        else if (arg == "--fast")
+            options.mFast = true;
+        // Play back without drawing, quitting at the end of the recording
+        else if (arg == "--headless")
+            options.mHeadless = true;
+        // Profile, writing a Chrome trace of the latest zones on quitting or on Ctrl+P
+        else if (arg == "--trace" && hasValue)
+            options.mTracePath = argv[++i];
+        // Pace frames with the display's vertical sync instead of sleeping
+        else if (arg == "--vsync")
+            options.mVSync = true;
+    }
+
+    if (!replayPath.empty()) {
+        options.mPlayback = std::make_unique<InputPlayback>(replayPath);
+        if (!options.mPlayback->isOpen()) {
+            SDL_Log("Could not read recording %s", replayPath.c_str());
+            return SDL_APP_FAILURE;
+        }
+        worldSeed = options.mPlayback->getWorldSeed();
+    } else if (options.mHeadless) {
+        SDL_Log("--headless needs a recording to play back with --replay");
+        return SDL_APP_FAILURE;
+    }
+
+    if (!recordPath.empty()) {
+        options.mRecorder = std::make_unique<InputRecorder>(recordPath, worldSeed);
+        if (!options.mRecorder->isOpen()) {
+            SDL_Log("Could not open %s for recording", recordPath.c_str());
+            return SDL_APP_FAILURE;
+        }
+    }
+
+#ifndef SURVIVAL_PROFILING
+    if (!options.mTracePath.empty())
+        SDL_Log("Built without SURVIVAL_PROFILING, so the trace will be empty");
+#endif
+
+    // No window is shown, but the game still needs a renderer to load its font into
+    if (options.mHeadless)
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+
+    // Must be seeded before the Game creates any entities, since their IDs and streams derive from it
+    RandomStreams::getInstance().setWorldSeed(worldSeed);
+    SDL_Log("World seed: %llu", static_cast<unsigned long long>(worldSeed));
+
+    auto *appstate = new Game(std::move(options));
     *appstate_void = appstate;
 
     SDL_Log("Reached end of init!");
@@ -27,6 +101,10 @@ SDL_AppResult SDL_AppIterate(void *appstate_void) {
     Game *appState = static_cast<Game *>(appstate_void);
     appState->iterate();
 
+    // The simulation thread may have asked to quit, e.g. from the player's input
+    if (appState->shouldQuit())
+        return SDL_APP_SUCCESS;
+
     return SDL_APP_CONTINUE;
 }
 
@@ -0,0 +1,297 @@
+// Runs the simulation without a window or renderer, as fast as possible, and reports how quickly it ticks. Used for
+// scaling tests, e.g.
+//     survival_headless --ticks 20000 --world 3 --wolves 50 --bunnies 500 --workers 4
+// It can also check that hot paths stay within an allocation budget, failing if they don't, e.g.
+//     survival_headless --ticks 1000 --bunnies 200 --budget "Entity::plan=50"
+
+#include "AllocationCounter.h"
+#include "Entity/EntityManager.h"
+#include "Entity/NPCs/BunnyEntity.h"
+#include "Entity/NPCs/CatEntity.h"
+#include "Entity/NPCs/GlowbugEntity.h"
+#include "Entity/NPCs/WolfEntity.h"
+#include "Entity/PlayerEntity.h"
+#include "Entity/UI/StatusUIEntity.h"
+#include "JobSystem.h"
+#include "ObjectPool.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "World.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+struct Options {
+    uint64_t mSeed{1};
+    unsigned long mTicks{10000};
+    /// Screens are generated up to this many screens away from the player's, at least 1
+    int mWorldRadius{1};
+    int mWolves{0};
+    int mBunnies{0};
+    int mCats{0};
+    int mGlowbugs{0};
+    /// Where to write a Chrome trace of the profiled zones, or empty to not profile
+    std::string mTracePath;
+    /// Report the allocations made in each allocation zone
+    bool mZones{false};
+    /// Report how full each object pool is
+    bool mPools{false};
+    /// Most allocations per tick allowed in each of these zones
+    std::vector<std::pair<std::string, double>> mBudgets;
+};
+
+void printUsage() {
+    std::printf("Usage: survival_headless [--seed N] [--ticks N] [--world RADIUS] [--wolves N] [--bunnies N]\n"
+                "                         [--cats N] [--glowbugs N] [--workers N] [--trace FILE] [--zones]\n"
+                "                         [--pools] [--budget ZONE=N]...\n"
+                "Extra NPCs are spawned on the player's screen and the screens around it, which are the ones that\n"
+                "tick in full. Screens further away, with --world 2 or more, are caught up less often. --trace\n"
+                "writes a Chrome trace of the latest profiled zones to FILE. --zones reports the allocations per\n"
+                "tick made in each ALLOCATION_ZONE, and --budget fails the run if ZONE averages more than N\n"
+                "allocations per tick. --pools reports the live objects and capacity of each type's pool\n");
+}
+
+/// Peak resident set size of the process in bytes, or 0 if it cannot be found on this platform
+size_t getPeakMemory() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    // Linux reports kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+/// Add count entities of type T at random positions on the player's and the surrounding screens
+template <typename T> void spawn(int count, Point playerWorldPos, Pcg32 &random) {
+    auto &manager = EntityManager::getInstance();
+    const Point origin = World::worldPosToWorld(playerWorldPos - Point(1, 1));
+    for (int i = 0; i < count; ++i) {
+        auto entity = std::make_unique<T>();
+        entity->setPos(origin + Point(static_cast<int>(random.nextBelow(3 * World::SCREEN_WIDTH)),
+                                      static_cast<int>(random.nextBelow(3 * World::SCREEN_HEIGHT))));
+        manager.addEntity(std::move(entity));
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--help") {
+            printUsage();
+            return 0;
+        }
+        if (arg == "--zones") {
+            options.mZones = true;
+            continue;
+        }
+        if (arg == "--pools") {
+            options.mPools = true;
+            continue;
+        }
+        if (i + 1 == argc) {
+            printUsage();
+            return 1;
+        }
+
+        const char *value = argv[++i];
+        if (arg == "--seed")
+            options.mSeed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--ticks")
+            options.mTicks = std::strtoul(value, nullptr, 10);
+        else if (arg == "--world")
+            options.mWorldRadius = std::max(1, std::atoi(value));
+        else if (arg == "--wolves")
+            options.mWolves = std::atoi(value);
+        else if (arg == "--bunnies")
+            options.mBunnies = std::atoi(value);
+        else if (arg == "--cats")
+            options.mCats = std::atoi(value);
+        else if (arg == "--glowbugs")
+            options.mGlowbugs = std::atoi(value);
+        else if (arg == "--workers")
+            JobSystem::getInstance().setNumWorkers(static_cast<unsigned>(std::strtoul(value, nullptr, 10)));
+        else if (arg == "--trace")
+            options.mTracePath = value;
+        else if (arg == "--budget") {
+            const std::string budget(value);
+            const auto equals = budget.rfind('=');
+            if (equals == std::string::npos) {
+                printUsage();
+                return 1;
+            }
+            options.mBudgets.emplace_back(budget.substr(0, equals), std::atof(budget.c_str() + equals + 1));
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    auto &profiler = Profiler::getInstance();
+    profiler.setThreadName("Simulation");
+    if (!options.mTracePath.empty())
+        profiler.setRecording(true);
+
+    auto &allocationTracker = AllocationTracker::getInstance();
+    const bool trackAllocations = options.mZones || !options.mBudgets.empty();
+#ifndef SURVIVAL_PROFILING
+    if (!options.mBudgets.empty()) {
+        std::fprintf(stderr, "Built without SURVIVAL_PROFILING, so allocations are not counted and --budget cannot be "
+                             "checked\n");
+        return 1;
+    }
+    if (trackAllocations)
+        std::fprintf(stderr, "Built without SURVIVAL_PROFILING, so there are no allocation zones\n");
+#endif
+
+    using Clock = std::chrono::steady_clock;
+    auto setupStart = Clock::now();
+
+    RandomStreams::getInstance().setWorldSeed(options.mSeed);
+    auto &manager = EntityManager::getInstance();
+
+    // Same starting position as the game
+    auto player = std::make_unique<PlayerEntity>();
+    player->setPos(World::SCREEN_WIDTH * 1000 + World::SCREEN_WIDTH / 2,
+                   World::SCREEN_HEIGHT * 1000 + World::SCREEN_HEIGHT / 2);
+    auto *playerPtr = player.get();
+    manager.addEntity(std::move(player));
+    // Behaviours report to the status bar even though it is never drawn
+    manager.addEntity(std::make_unique<StatusUIEntity>(*playerPtr));
+    const Point playerWorldPos = playerPtr->getWorldPos();
+
+    World world;
+    for (int y = -options.mWorldRadius + 1; y < options.mWorldRadius; ++y)
+        for (int x = -options.mWorldRadius + 1; x < options.mWorldRadius; ++x)
+            world.randomizeScreensAround(playerWorldPos + Point(x, y));
+
+    auto &random = RandomStreams::getInstance().getStream(RandomStream::WORLD_GENERATION);
+    spawn<WolfEntity>(options.mWolves, playerWorldPos, random);
+    spawn<BunnyEntity>(options.mBunnies, playerWorldPos, random);
+    spawn<CatEntity>(options.mCats, playerWorldPos, random);
+    spawn<GlowbugEntity>(options.mGlowbugs, playerWorldPos, random);
+
+    manager.initialize();
+    const double setupSeconds = std::chrono::duration<double>(Clock::now() - setupStart).count();
+
+    // Only count the allocations made while ticking
+    allocationTracker.resetZones();
+    allocationTracker.setTracking(trackAllocations);
+
+    TickTimings total;
+    auto runStart = Clock::now();
+    for (unsigned long tick = 0; tick < options.mTicks; ++tick) {
+        // Keep the player alive so that the population behaves the same throughout the run
+        playerPtr->hunger = 1;
+        playerPtr->mHp = playerPtr->mMaxHp;
+
+        manager.tick();
+
+        const auto &timings = manager.getLastTickTimings();
+        total.mWake += timings.mWake;
+        total.mCatchUp += timings.mCatchUp;
+        total.mPrepare += timings.mPrepare;
+        total.mPlan += timings.mPlan;
+        total.mApply += timings.mApply;
+        total.mSleep += timings.mSleep;
+        total.mNumTicked += timings.mNumTicked;
+        total.mNumCaughtUp += timings.mNumCaughtUp;
+        total.mAllocations.mAllocations += timings.mAllocations.mAllocations;
+        total.mAllocations.mBytes += timings.mAllocations.mBytes;
+    }
+    allocationTracker.setTracking(false);
+    const double runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+
+    const double ticks = options.mTicks > 0 ? static_cast<double>(options.mTicks) : 1.0;
+    auto perTick = [ticks](double seconds) { return 1000.0 * seconds / ticks; };
+
+    const int worldWidth = 2 * options.mWorldRadius + 1;
+    std::printf("seed %llu, %u workers, %d screens, %d entities\n", static_cast<unsigned long long>(options.mSeed),
+                JobSystem::getInstance().getNumWorkers(), worldWidth * worldWidth, gNumInitialisedEntities);
+    std::printf("setup        %10.3f s\n", setupSeconds);
+    std::printf("ticks        %10lu in %.3f s, %.1f ticks/s\n", options.mTicks, runSeconds,
+                runSeconds > 0 ? static_cast<double>(options.mTicks) / runSeconds : 0.0);
+    std::printf("ticked       %10.1f entities/tick\n", static_cast<double>(total.mNumTicked) / ticks);
+    std::printf("wake         %10.4f ms/tick\n", perTick(total.mWake));
+    std::printf("catch-up     %10.4f ms/tick, %.1f entities/tick\n", perTick(total.mCatchUp),
+                static_cast<double>(total.mNumCaughtUp) / ticks);
+    std::printf("prepare      %10.4f ms/tick\n", perTick(total.mPrepare));
+    std::printf("plan         %10.4f ms/tick\n", perTick(total.mPlan));
+    std::printf("apply        %10.4f ms/tick\n", perTick(total.mApply));
+    std::printf("sleep        %10.4f ms/tick\n", perTick(total.mSleep));
+    if (isCountingAllocations())
+        std::printf("allocations  %10.1f/tick, %.1f KiB/tick\n",
+                    static_cast<double>(total.mAllocations.mAllocations) / ticks,
+                    static_cast<double>(total.mAllocations.mBytes) / 1024.0 / ticks);
+    else
+        std::printf("allocations  not counted, built without SURVIVAL_PROFILING\n");
+    std::printf("peak memory  %10.1f MiB\n", static_cast<double>(getPeakMemory()) / (1024.0 * 1024.0));
+    std::printf("state hash   %016llx\n", static_cast<unsigned long long>(manager.computeStateHash()));
+
+    auto zones = allocationTracker.getZones();
+    if (options.mZones) {
+        std::sort(zones.begin(), zones.end(), [](const AllocationZoneStats *a, const AllocationZoneStats *b) {
+            return a->mAllocations.load() > b->mAllocations.load();
+        });
+        std::printf("\n%-48s %12s %12s\n", "allocation zone", "allocs/tick", "KiB/tick");
+        for (const auto zone : zones)
+            std::printf("%-48s %12.1f %12.2f\n", zone->mName.c_str(), static_cast<double>(zone->mAllocations) / ticks,
+                        static_cast<double>(zone->mBytes) / 1024.0 / ticks);
+    }
+
+    if (options.mPools) {
+        auto pools = ObjectPool::getPools();
+        std::sort(pools.begin(), pools.end(),
+                  [](const ObjectPool *a, const ObjectPool *b) { return a->getCapacity() > b->getCapacity(); });
+        std::printf("\n%-48s %12s %12s\n", "object pool", "live", "capacity");
+        for (const auto pool : pools)
+            std::printf("%-48s %12zu %12zu\n", pool->getName(), pool->getLiveCount(), pool->getCapacity());
+    }
+
+    bool withinBudget = true;
+    for (const auto &budget : options.mBudgets) {
+        auto zone = std::find_if(zones.cbegin(), zones.cend(),
+                                 [&budget](const AllocationZoneStats *stats) { return stats->mName == budget.first; });
+        if (zone == zones.cend()) {
+            std::fprintf(stderr, "No allocation zone called %s\n", budget.first.c_str());
+            withinBudget = false;
+            continue;
+        }
+        const double perTick = static_cast<double>((*zone)->mAllocations) / ticks;
+        if (perTick > budget.second) {
+            std::fprintf(stderr, "%s made %.1f allocations per tick, over its budget of %.1f\n", budget.first.c_str(),
+                         perTick, budget.second);
+            withinBudget = false;
+        }
+    }
+
+    if (!options.mTracePath.empty()) {
+#ifndef SURVIVAL_PROFILING
+        std::fprintf(stderr, "Built without SURVIVAL_PROFILING, so the trace is empty\n");
+#endif
+        if (!profiler.writeChromeTrace(options.mTracePath)) {
+            std::fprintf(stderr, "Could not write %s\n", options.mTracePath.c_str());
+            return 1;
+        }
+    }
+
+    return withinBudget ? 0 : 2;
+}
@@ -1,10 +1,6 @@
 #include "utils.h"
-#include <cstdlib>
-#include <ctime>
 #include <sstream>
 
-double randDouble() { return static_cast<double>(rand()) / static_cast<double>(RAND_MAX); }
-
 std::vector<std::string> wordWrap(const std::string &toBeWrapped, size_t columns) {
     std::vector<std::string> lines;
     size_t index = 0;
@@ -26,9 +22,3 @@ std::string repeat(int n, const std::string &str) {
         os << str;
     return os.str();
 }
-
-clock_t gStartTime;
-
-void beginTime() { gStartTime = clock(); }
-
-float endTime() { return (float)(clock() - gStartTime) / CLOCKS_PER_SEC; }